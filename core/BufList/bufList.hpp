@@ -2,15 +2,86 @@
 #define __BUF_LIST_HPP__
 
 #include <list>
+#include <deque>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
 #include <string>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+// 多队列等待的共享通知器
+// 队列由空变为非空或被关闭时递增序号并唤醒所有等待者，
+// 等待者先记录序号、再检查各队列，避免丢失通知
+class BufListNotifier {
+    public:
+        void notify() {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                ++_seq;
+            }
+            _cv.notify_all();
+        }
+
+        uint64_t sequence() const {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _seq;
+        }
+
+        // 等待序号离开 last（阻塞/超时），ms 语义同 BufList::read
+        bool wait(uint64_t last, int64_t ms) {
+            std::unique_lock<std::mutex> lock(_mtx);
+            auto changed = [&]() { return _seq != last; };
+            if (ms > 0) {
+                return _cv.wait_for(lock, std::chrono::milliseconds(ms), changed);
+            } else if (ms < 0) {
+                _cv.wait(lock, changed);
+            }
+            return changed();
+        }
+
+    private:
+        mutable std::mutex _mtx;
+        std::condition_variable _cv;
+        uint64_t _seq = 0;
+};
+
+// 队列统计快照
+struct BufListStats {
+    std::string name;                  // 队列名称
+    size_t size = 0;                   // 当前元素数
+    size_t max_size = 0;               // 容量
+    size_t high_water = 0;             // 历史最大元素数
+    uint64_t enqueues = 0;             // 成功写入次数
+    uint64_t dequeues = 0;             // 成功读取次数
+    uint64_t rejected_writes = 0;      // 失败的写入次数(满、超时或已关闭)
+    uint64_t write_timeouts = 0;       // 写入超时次数
+    uint64_t read_timeouts = 0;        // 读取超时次数
+    uint64_t producer_blocked_ns = 0;  // 写线程累计阻塞时间
+    uint64_t consumer_blocked_ns = 0;  // 读线程累计阻塞时间
+    uint64_t sojourn_samples = 0;      // 驻留时间采样数
+    uint64_t sojourn_total_ns = 0;     // 采样元素累计驻留时间
+    uint64_t sojourn_max_ns = 0;       // 采样元素最大驻留时间
+
+    // 平均驻留时间(ns)
+    double avg_sojourn_ns() const {
+        return sojourn_samples ? static_cast<double>(sojourn_total_ns) / sojourn_samples : 0.0;
+    }
+};
 
 template<typename T>
 class BufList {
     public:
-        BufList(size_t max_size = 100, const std::string& name = "") 
+        BufList(size_t max_size = 100, const std::string& name = "")
             : _max_size(max_size), _name(name) {}
 
         // 禁止拷贝
@@ -21,6 +92,12 @@ class BufList {
         BufList(BufList&&) = default;
         BufList& operator=(BufList&&) = default;
 
+        ~BufList() {
+#ifdef __linux__
+            if (_event_fd >= 0) ::close(_event_fd);
+#endif
+        }
+
         void set_name(const std::string& name) {
             std::lock_guard<std::mutex> lock(_mtx);
             _name = name;
@@ -38,24 +115,78 @@ class BufList {
 
         void clear() {
             std::lock_guard<std::mutex> lock(_mtx);
+            _deq_seq += _buf.size();
             _buf.clear();
+            _sojourn_marks.clear();
+            if (!_closed) drain_event_fd();
+            _not_full.notify_all();
+        }
+
+        // 关闭队列：之后的写入立即失败，读取可继续取完剩余数据
+        // 唤醒所有阻塞中的读写线程以及挂接的通知器
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                if (_closed) return;
+                _closed = true;
+                if (_buf.empty()) signal_readable();
+            }
+            _not_empty.notify_all();
+            _not_full.notify_all();
+        }
+
+        // 是否可读：有数据或已关闭（read 不会阻塞）
+        bool readable() const {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _closed || !_buf.empty();
+        }
+
+        // 挂接共享通知器，队列由空变为非空或关闭时触发
+        void attach_notifier(const std::shared_ptr<BufListNotifier>& notifier) {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _notifiers.push_back(notifier);
+        }
+
+        void detach_notifier(const std::shared_ptr<BufListNotifier>& notifier) {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _notifiers.erase(std::remove(_notifiers.begin(), _notifiers.end(), notifier),
+                             _notifiers.end());
+        }
+
+        // 返回与队列可读状态同步的 eventfd，可加入 epoll/poll
+        // 队列非空或已关闭时 fd 可读；fd 只反映状态，数据仍须通过 read 取出
+        // 首次调用时创建，仅在状态翻转时产生系统调用；非 Linux 平台返回 -1
+        int event_fd() {
+#ifdef __linux__
+            std::lock_guard<std::mutex> lock(_mtx);
+            if (_event_fd < 0) {
+                _event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+                if (_event_fd >= 0 && (_closed || !_buf.empty())) {
+                    uint64_t one = 1;
+                    ssize_t ret = ::write(_event_fd, &one, sizeof(one));
+                    (void)ret;
+                }
+            }
+            return _event_fd;
+#else
+            return -1;
+#endif
+        }
+
+        // 是否已关闭；read 返回 false 且 is_closed() 为 true 表示数据已取完
+        bool is_closed() const {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _closed;
         }
 
         // 写入（阻塞/超时/非阻塞）
         // ms = 0: 不阻塞；<0：永久阻塞；>0 超时
+        // 队列关闭后返回 false
         bool write(const T& value, int64_t ms = 0) {
             std::unique_lock<std::mutex> lock(_mtx);
-            auto is_full = [&]() { return _buf.size() >= _max_size; };
-            if (ms == 0) {
-                if (is_full()) return false;
-            } else if (ms > 0) {
-                if (! _not_full.wait_for(lock, std::chrono::milliseconds(ms), [&]() { return !is_full(); })) {
-                    return false;
-                }
-            } else {
-                _not_full.wait(lock, [&]() { return !is_full(); });
-            }
+            if (!wait_not_full(lock, ms)) return false;
             _buf.emplace_back(value);
+            on_enqueue();
             _not_empty.notify_one();
             return true;
         }
@@ -63,52 +194,141 @@ class BufList {
         // 移动写入
         bool write(T&& value, int64_t ms = 0) {
             std::unique_lock<std::mutex> lock(_mtx);
-            auto is_full = [&]() { return _buf.size() >= _max_size; };
+            if (!wait_not_full(lock, ms)) return false;
+            _buf.emplace_back(std::move(value));
+            on_enqueue();
+            _not_empty.notify_one();
+            return true;
+        }
+
+        // 原地构造写入（永久阻塞直到有空位）
+        template<typename... Args>
+        bool emplace(Args&&... args) {
+            return try_emplace(-1, std::forward<Args>(args)...);
+        }
+
+        // 原地构造写入（阻塞/超时/非阻塞），ms 语义同 write
+        // 节点在锁外构造，锁内只做 O(1) 的 splice，不产生临时对象和额外的移动
+        // 非阻塞写入先检查容量，队列已满或已关闭时不构造元素
+        template<typename... Args>
+        bool try_emplace(int64_t ms, Args&&... args) {
             if (ms == 0) {
-                if (is_full()) return false;
-            } else if (ms > 0) {
-                if (! _not_full.wait_for(lock, std::chrono::milliseconds(ms), [&]() { return !is_full(); })) {
-                    return false;
-                }
-            } else {
-                _not_full.wait(lock, [&]() { return !is_full(); });
+                std::unique_lock<std::mutex> lock(_mtx);
+                if (!wait_not_full(lock, 0)) return false;
             }
-            _buf.emplace_back(std::move(value));
+            std::list<T> node;
+            node.emplace_back(std::forward<Args>(args)...);
+
+            std::unique_lock<std::mutex> lock(_mtx);
+            if (!wait_not_full(lock, ms)) return false;
+            _buf.splice(_buf.end(), node);
+            on_enqueue();
             _not_empty.notify_one();
             return true;
         }
-    
+
         // 读取（阻塞/超时/非阻塞）
         // out: 读取到的数据
         // ms = 0: 不阻塞；<0：永久阻塞；>0 超时
+        // 队列关闭后仍可读出剩余数据，取完后返回 false
         bool read(T& out, int64_t ms = 0) {
             std::unique_lock<std::mutex> lock(_mtx);
-            auto is_empty = [&]() { return _buf.empty(); };
-            if (ms == 0) {
-                if (is_empty()) return false;
-            } else if (ms > 0) {
-                if (! _not_empty.wait_for(lock, std::chrono::milliseconds(ms), [&]() { return !is_empty(); })) {
-                    return false;
-                }
-            } else {
-                _not_empty.wait(lock, [&]() { return !is_empty(); });
-            }
+            if (!wait_not_empty(lock, ms)) return false;
             out = std::move(_buf.front());
             _buf.pop_front();
+            on_dequeue();
             _not_full.notify_one();
             return true;
         }
-    
+
+        // 取出队首元素并在锁外原地处理（阻塞/超时/非阻塞），ms 语义同 read
+        // fn: 形如 void(T&) 的回调，正常返回即提交，元素随后销毁
+        // 队首节点被 splice 出队列，回调期间不持锁，也不发生元素的移动或拷贝
+        // 回调抛出异常时元素放回队首（不受容量限制，关闭后仍可读出），异常继续抛出
+        template<typename Fn>
+        bool read_with(Fn&& fn, int64_t ms = 0) {
+            std::list<T> claimed;
+            {
+                std::unique_lock<std::mutex> lock(_mtx);
+                if (!wait_not_empty(lock, ms)) return false;
+                claimed.splice(claimed.end(), _buf, _buf.begin());
+                on_dequeue();
+                _not_full.notify_one();
+            }
+            try {
+                fn(claimed.front());
+            } catch (...) {
+                requeue_front(claimed);
+                throw;
+            }
+            return true;
+        }
+
         // 唤醒一个阻塞中的写操作
         void resume_writer() {
             _not_full.notify_one();
         }
-    
+
         // 唤醒一个阻塞中的读操作
         void resume_reader() {
             _not_empty.notify_one();
         }
 
+        // 获取统计快照，计数器无锁读取，仅名称和当前大小需要加锁
+        BufListStats stats() const {
+            BufListStats st;
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                st.name = _name;
+                st.size = _buf.size();
+                st.max_size = _max_size;
+            }
+            st.high_water = _high_water.load(std::memory_order_relaxed);
+            st.enqueues = _enqueues.load(std::memory_order_relaxed);
+            st.dequeues = _dequeues.load(std::memory_order_relaxed);
+            st.rejected_writes = _rejected_writes.load(std::memory_order_relaxed);
+            st.write_timeouts = _write_timeouts.load(std::memory_order_relaxed);
+            st.read_timeouts = _read_timeouts.load(std::memory_order_relaxed);
+            st.producer_blocked_ns = _producer_blocked_ns.load(std::memory_order_relaxed);
+            st.consumer_blocked_ns = _consumer_blocked_ns.load(std::memory_order_relaxed);
+            st.sojourn_samples = _sojourn_samples.load(std::memory_order_relaxed);
+            st.sojourn_total_ns = _sojourn_total_ns.load(std::memory_order_relaxed);
+            st.sojourn_max_ns = _sojourn_max_ns.load(std::memory_order_relaxed);
+            return st;
+        }
+
+        // 清零统计计数
+        void reset_stats() {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _high_water.store(_buf.size(), std::memory_order_relaxed);
+            _enqueues.store(0, std::memory_order_relaxed);
+            _dequeues.store(0, std::memory_order_relaxed);
+            _rejected_writes.store(0, std::memory_order_relaxed);
+            _write_timeouts.store(0, std::memory_order_relaxed);
+            _read_timeouts.store(0, std::memory_order_relaxed);
+            _producer_blocked_ns.store(0, std::memory_order_relaxed);
+            _consumer_blocked_ns.store(0, std::memory_order_relaxed);
+            _sojourn_samples.store(0, std::memory_order_relaxed);
+            _sojourn_total_ns.store(0, std::memory_order_relaxed);
+            _sojourn_max_ns.store(0, std::memory_order_relaxed);
+        }
+
+        // 打印统计信息
+        void printStats(std::ostream& os = std::cout) const {
+            BufListStats st = stats();
+            os << "BufList[" << st.name << "] Stats:" << std::endl;
+            os << "  Size: " << st.size << "/" << st.max_size
+               << " (high water: " << st.high_water << ")" << std::endl;
+            os << "  Enqueues: " << st.enqueues << ", Dequeues: " << st.dequeues << std::endl;
+            os << "  Rejected writes: " << st.rejected_writes
+               << " (timeouts: " << st.write_timeouts << ")" << std::endl;
+            os << "  Read timeouts: " << st.read_timeouts << std::endl;
+            os << "  Producer blocked: " << st.producer_blocked_ns / 1000000.0 << " ms" << std::endl;
+            os << "  Consumer blocked: " << st.consumer_blocked_ns / 1000000.0 << " ms" << std::endl;
+            os << "  Sojourn: avg " << st.avg_sojourn_ns() / 1000.0 << " us, max "
+               << st.sojourn_max_ns / 1000.0 << " us (" << st.sojourn_samples << " samples)" << std::endl;
+        }
+
         // 打印内容（须重载<<支持T的打印）
         void print() const {
             std::lock_guard<std::mutex> lock(_mtx);
@@ -119,12 +339,151 @@ class BufList {
         }
 
     private:
+        using Clock = std::chrono::steady_clock;
+
+        // 每写入多少个元素采样一次驻留时间(须为2的幂)
+        static constexpr uint64_t SOJOURN_SAMPLE_INTERVAL = 64;
+
+        static uint64_t elapsed_ns(Clock::time_point start) {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+
+        // 等待队列有空位，返回false表示非阻塞失败、超时或队列已关闭
+        bool wait_not_full(std::unique_lock<std::mutex>& lock, int64_t ms) {
+            auto ready = [&]() { return _closed || _buf.size() < _max_size; };
+            if (ms != 0 && !ready()) {
+                Clock::time_point start = Clock::now();
+                if (ms > 0) {
+                    _not_full.wait_for(lock, std::chrono::milliseconds(ms), ready);
+                } else {
+                    _not_full.wait(lock, ready);
+                }
+                _producer_blocked_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+            }
+            if (!_closed && _buf.size() < _max_size) return true;
+
+            _rejected_writes.fetch_add(1, std::memory_order_relaxed);
+            if (ms > 0 && !_closed) {
+                _write_timeouts.fetch_add(1, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        // 等待队列有数据，返回false表示非阻塞失败、超时或队列已关闭且取空
+        bool wait_not_empty(std::unique_lock<std::mutex>& lock, int64_t ms) {
+            auto ready = [&]() { return _closed || !_buf.empty(); };
+            if (ms != 0 && !ready()) {
+                Clock::time_point start = Clock::now();
+                if (ms > 0) {
+                    _not_empty.wait_for(lock, std::chrono::milliseconds(ms), ready);
+                } else {
+                    _not_empty.wait(lock, ready);
+                }
+                _consumer_blocked_ns.fetch_add(elapsed_ns(start), std::memory_order_relaxed);
+            }
+            if (!_buf.empty()) return true;
+
+            if (ms > 0 && !_closed) {
+                _read_timeouts.fetch_add(1, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        // 队列变为可读时通知 eventfd 和挂接的通知器(持锁)
+        void signal_readable() {
+#ifdef __linux__
+            if (_event_fd >= 0) {
+                uint64_t one = 1;
+                ssize_t ret = ::write(_event_fd, &one, sizeof(one));
+                (void)ret;
+            }
+#endif
+            for (const auto& notifier : _notifiers) {
+                notifier->notify();
+            }
+        }
+
+        // 队列取空后清除 eventfd 的可读状态(持锁)
+        void drain_event_fd() {
+#ifdef __linux__
+            if (_event_fd >= 0) {
+                uint64_t value = 0;
+                ssize_t ret = ::read(_event_fd, &value, sizeof(value));
+                (void)ret;
+            }
+#endif
+        }
+
+        // 写入成功后调用(持锁)
+        void on_enqueue() {
+            _enqueues.fetch_add(1, std::memory_order_relaxed);
+            size_t cur = _buf.size();
+            if (cur == 1) signal_readable();
+            if (cur > _high_water.load(std::memory_order_relaxed)) {
+                _high_water.store(cur, std::memory_order_relaxed);
+            }
+            if ((_enq_seq & (SOJOURN_SAMPLE_INTERVAL - 1)) == 0) {
+                _sojourn_marks.emplace_back(_enq_seq, Clock::now());
+            }
+            ++_enq_seq;
+        }
+
+        // 撤销一次出队：把已取出的节点放回队首并回退出队计数
+        void requeue_front(std::list<T>& node) {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                _buf.splice(_buf.begin(), node);
+                _dequeues.fetch_sub(1, std::memory_order_relaxed);
+                --_deq_seq;
+                if (_buf.size() == 1 && !_closed) signal_readable();
+            }
+            _not_empty.notify_one();
+        }
+
+        // 读取成功后调用(持锁)
+        void on_dequeue() {
+            _dequeues.fetch_add(1, std::memory_order_relaxed);
+            if (!_sojourn_marks.empty() && _sojourn_marks.front().first == _deq_seq) {
+                uint64_t ns = elapsed_ns(_sojourn_marks.front().second);
+                _sojourn_marks.pop_front();
+                _sojourn_samples.fetch_add(1, std::memory_order_relaxed);
+                _sojourn_total_ns.fetch_add(ns, std::memory_order_relaxed);
+                if (ns > _sojourn_max_ns.load(std::memory_order_relaxed)) {
+                    _sojourn_max_ns.store(ns, std::memory_order_relaxed);
+                }
+            }
+            ++_deq_seq;
+            if (_buf.empty() && !_closed) drain_event_fd();
+        }
+
         mutable std::mutex _mtx;
         std::condition_variable _not_empty;
         std::condition_variable _not_full;
         std::list<T> _buf;
         size_t _max_size;
         std::string _name;
+        bool _closed = false;
+        int _event_fd = -1;                                        // 可读状态 eventfd
+        std::vector<std::shared_ptr<BufListNotifier>> _notifiers;  // 挂接的通知器
+
+        // 统计计数，持锁更新，无锁读取
+        std::atomic<size_t> _high_water{0};
+        std::atomic<uint64_t> _enqueues{0};
+        std::atomic<uint64_t> _dequeues{0};
+        std::atomic<uint64_t> _rejected_writes{0};
+        std::atomic<uint64_t> _write_timeouts{0};
+        std::atomic<uint64_t> _read_timeouts{0};
+        std::atomic<uint64_t> _producer_blocked_ns{0};
+        std::atomic<uint64_t> _consumer_blocked_ns{0};
+        std::atomic<uint64_t> _sojourn_samples{0};
+        std::atomic<uint64_t> _sojourn_total_ns{0};
+        std::atomic<uint64_t> _sojourn_max_ns{0};
+
+        // 驻留时间采样：元素序号 -> 写入时间，按FIFO顺序与出队序号匹配
+        uint64_t _enq_seq = 0;
+        uint64_t _deq_seq = 0;
+        std::deque<std::pair<uint64_t, Clock::time_point>> _sojourn_marks;
 };
 
-#endif // __BUF_LIST_HPP__
\ No newline at end of file
+#endif // __BUF_LIST_HPP__
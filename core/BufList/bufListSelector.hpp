@@ -0,0 +1,108 @@
+#ifndef __BUF_LIST_SELECTOR_HPP__
+#define __BUF_LIST_SELECTOR_HPP__
+
+#include <vector>
+#include <functional>
+#include <memory>
+#include <chrono>
+#include "bufList.hpp"
+
+/**
+ * @brief 在多个 BufList 上等待任一可读（select 语义）
+ *
+ * 被加入的队列挂接同一个 BufListNotifier，队列由空变为非空或被关闭时
+ * 唤醒 select()，等待期间不轮询、不占用 CPU。
+ * 队列可以是不同的元素类型；selector 必须先于被加入的队列析构，或显式 remove_all()。
+ *
+ * 用法：
+ *   BufListSelector sel;
+ *   size_t ctrl = sel.add(ctrl_list);
+ *   size_t data = sel.add(data_list);
+ *   int idx = sel.select(-1);
+ *   if (idx == (int)ctrl) ctrl_list.read(msg);
+ */
+class BufListSelector {
+    public:
+        BufListSelector() : _notifier(std::make_shared<BufListNotifier>()) {}
+
+        ~BufListSelector() {
+            remove_all();
+        }
+
+        // 禁止拷贝
+        BufListSelector(const BufListSelector&) = delete;
+        BufListSelector& operator=(const BufListSelector&) = delete;
+
+        // 加入一个队列，返回其在 select() 结果中的下标
+        template<typename T>
+        size_t add(BufList<T>& list) {
+            list.attach_notifier(_notifier);
+            Entry entry;
+            entry.readable = [&list]() { return list.readable(); };
+            entry.detach = [&list](const std::shared_ptr<BufListNotifier>& n) { list.detach_notifier(n); };
+            _entries.push_back(std::move(entry));
+            return _entries.size() - 1;
+        }
+
+        // 解除所有队列的挂接
+        void remove_all() {
+            for (auto& entry : _entries) {
+                entry.detach(_notifier);
+            }
+            _entries.clear();
+        }
+
+        size_t count() const {
+            return _entries.size();
+        }
+
+        // 等待任一队列可读（有数据或已关闭）
+        // ms = 0: 不阻塞；<0：永久阻塞；>0 超时
+        // 返回可读队列的下标，超时或无队列返回 -1
+        // 多个队列同时可读时轮转起始位置，避免靠前的队列饿死后面的队列
+        int select(int64_t ms = -1) {
+            if (_entries.empty()) return -1;
+
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms > 0 ? ms : 0);
+            while (true) {
+                uint64_t seq = _notifier->sequence();
+                int idx = poll_once();
+                if (idx >= 0) return idx;
+
+                int64_t wait_ms = ms;
+                if (ms > 0) {
+                    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now()).count();
+                    if (left <= 0) return -1;
+                    wait_ms = left;
+                }
+                if (!_notifier->wait(seq, wait_ms)) {
+                    return poll_once();
+                }
+            }
+        }
+
+    private:
+        struct Entry {
+            std::function<bool()> readable;
+            std::function<void(const std::shared_ptr<BufListNotifier>&)> detach;
+        };
+
+        int poll_once() {
+            size_t n = _entries.size();
+            for (size_t i = 0; i < n; ++i) {
+                size_t idx = (_next + i) % n;
+                if (_entries[idx].readable()) {
+                    _next = (idx + 1) % n;
+                    return static_cast<int>(idx);
+                }
+            }
+            return -1;
+        }
+
+        std::shared_ptr<BufListNotifier> _notifier;
+        std::vector<Entry> _entries;
+        size_t _next = 0;    // 下一次轮询的起始下标
+};
+
+#endif // __BUF_LIST_SELECTOR_HPP__
@@ -0,0 +1,266 @@
+#ifndef __PRIORITY_BUF_LIST_HPP__
+#define __PRIORITY_BUF_LIST_HPP__
+
+#include <list>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <stdexcept>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief 多优先级通道的阻塞队列
+ *
+ * 与 BufList 的容量统计、阻塞/超时语义和 close() 语义一致，
+ * 区别在于元素按通道(lane)存放：lane 0 优先级最高。
+ * 读取时通过非空通道位图取最低置位，O(1) 找到优先级最高的非空通道，
+ * 同一通道内保持 FIFO。所有通道共享 max_size 容量。
+ * 写入同样按优先级准入：每个通道有独立的 not_full 条件变量，
+ * 腾出空位时先唤醒优先级最高的等待通道；高优先级通道有写线程等待时，
+ * 低优先级通道不得占用空位，队列饱和时控制通道不会被大量批量写入饿死。
+ *
+ * @tparam T 元素类型
+ * @tparam Lanes 通道数量(1~64)
+ */
+template<typename T, size_t Lanes = 2>
+class PriorityBufList {
+    static_assert(Lanes >= 1 && Lanes <= 64, "Lanes must be in [1, 64]");
+
+    public:
+        PriorityBufList(size_t max_size = 100, const std::string& name = "")
+            : _max_size(max_size), _name(name) {}
+
+        // 禁止拷贝
+        PriorityBufList(const PriorityBufList&) = delete;
+        PriorityBufList& operator=(const PriorityBufList&) = delete;
+
+        static constexpr size_t lanes() { return Lanes; }
+
+        void set_name(const std::string& name) {
+            std::lock_guard<std::mutex> lock(_mtx);
+            _name = name;
+        }
+
+        std::string get_name() const {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _name;
+        }
+
+        // 所有通道的元素总数
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _size;
+        }
+
+        // 指定通道的元素数
+        size_t size(size_t lane) const {
+            check_lane(lane);
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _lanes[lane].size();
+        }
+
+        void clear() {
+            std::lock_guard<std::mutex> lock(_mtx);
+            for (size_t i = 0; i < Lanes; ++i) {
+                _lanes[i].clear();
+            }
+            _size = 0;
+            _ready_mask = 0;
+            notify_all_writers();
+        }
+
+        // 关闭队列：之后的写入立即失败，读取可继续取完剩余数据
+        void close() {
+            {
+                std::lock_guard<std::mutex> lock(_mtx);
+                _closed = true;
+            }
+            _not_empty.notify_all();
+            notify_all_writers();
+        }
+
+        bool is_closed() const {
+            std::lock_guard<std::mutex> lock(_mtx);
+            return _closed;
+        }
+
+        // 写入指定通道（阻塞/超时/非阻塞）
+        // ms = 0: 不阻塞；<0：永久阻塞；>0 超时
+        bool write(size_t lane, const T& value, int64_t ms = 0) {
+            return try_emplace(lane, ms, value);
+        }
+
+        bool write(size_t lane, T&& value, int64_t ms = 0) {
+            return try_emplace(lane, ms, std::move(value));
+        }
+
+        // 原地构造写入指定通道（永久阻塞直到有空位）
+        template<typename... Args>
+        bool emplace(size_t lane, Args&&... args) {
+            return try_emplace(lane, -1, std::forward<Args>(args)...);
+        }
+
+        // 原地构造写入指定通道（阻塞/超时/非阻塞），ms 语义同 write
+        // 非阻塞写入先检查准入，无法写入时不构造元素
+        template<typename... Args>
+        bool try_emplace(size_t lane, int64_t ms, Args&&... args) {
+            check_lane(lane);
+            if (ms == 0) {
+                std::lock_guard<std::mutex> lock(_mtx);
+                if (!can_write(lane)) return false;
+            }
+            std::list<T> node;
+            node.emplace_back(std::forward<Args>(args)...);
+
+            std::unique_lock<std::mutex> lock(_mtx);
+            if (!wait_not_full(lock, lane, ms)) return false;
+            _lanes[lane].splice(_lanes[lane].end(), node);
+            _ready_mask |= (uint64_t(1) << lane);
+            ++_size;
+            _not_empty.notify_one();
+            return true;
+        }
+
+        // 从优先级最高的非空通道读取（阻塞/超时/非阻塞）
+        // lane: 可选，返回数据所在通道
+        bool read(T& out, int64_t ms = 0, size_t* lane = nullptr) {
+            std::unique_lock<std::mutex> lock(_mtx);
+            if (!wait_not_empty(lock, ms)) return false;
+            size_t idx = highest_ready_lane();
+            out = std::move(_lanes[idx].front());
+            pop_front(idx);
+            if (lane) *lane = idx;
+            return true;
+        }
+
+        // 取出优先级最高的元素并在锁外原地处理，fn 形如 void(T&, size_t lane)
+        template<typename Fn>
+        bool read_with(Fn&& fn, int64_t ms = 0) {
+            std::list<T> claimed;
+            size_t idx = 0;
+            {
+                std::unique_lock<std::mutex> lock(_mtx);
+                if (!wait_not_empty(lock, ms)) return false;
+                idx = highest_ready_lane();
+                claimed.splice(claimed.end(), _lanes[idx], _lanes[idx].begin());
+                after_pop(idx);
+            }
+            fn(claimed.front(), idx);
+            return true;
+        }
+
+        // 唤醒优先级最高的通道中一个阻塞的写操作
+        void resume_writer() {
+            std::lock_guard<std::mutex> lock(_mtx);
+            notify_writer();
+        }
+
+        // 唤醒一个阻塞中的读操作
+        void resume_reader() {
+            _not_empty.notify_one();
+        }
+
+    private:
+        void check_lane(size_t lane) const {
+            if (lane >= Lanes) {
+                throw std::out_of_range("PriorityBufList: 无效的通道号");
+            }
+        }
+
+        // 最低置位的下标，调用前须保证 mask 非空
+        static size_t lowest_bit(uint64_t mask) {
+#if defined(_MSC_VER)
+            unsigned long idx = 0;
+            _BitScanForward64(&idx, mask);
+            return idx;
+#else
+            return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+        }
+
+        // 位图中最低置位即优先级最高的非空通道，调用前须保证位图非空
+        size_t highest_ready_lane() const {
+            return lowest_bit(_ready_mask);
+        }
+
+        void pop_front(size_t lane) {
+            _lanes[lane].pop_front();
+            after_pop(lane);
+        }
+
+        void after_pop(size_t lane) {
+            if (_lanes[lane].empty()) {
+                _ready_mask &= ~(uint64_t(1) << lane);
+            }
+            --_size;
+            notify_writer();
+        }
+
+        // 有空位且没有更高优先级的通道在等待时，lane 可以写入(持锁)
+        bool can_write(size_t lane) const {
+            uint64_t higher = (uint64_t(1) << lane) - 1;
+            return !_closed && _size < _max_size && (_waiting_mask & higher) == 0;
+        }
+
+        // 有空位时唤醒优先级最高的等待通道中的一个写线程(持锁)
+        void notify_writer() {
+            if (_waiting_mask != 0 && _size < _max_size) {
+                _not_full[lowest_bit(_waiting_mask)].notify_one();
+            }
+        }
+
+        void notify_all_writers() {
+            for (size_t i = 0; i < Lanes; ++i) {
+                _not_full[i].notify_all();
+            }
+        }
+
+        // 等待通道可写，返回false表示非阻塞失败、超时或队列已关闭
+        // 等待期间登记在 _waiting_mask 中，阻止低优先级通道抢占空位；
+        // 离开时若仍有空位，把唤醒传给下一个等待通道
+        bool wait_not_full(std::unique_lock<std::mutex>& lock, size_t lane, int64_t ms) {
+            if (ms != 0 && !can_write(lane)) {
+                auto ready = [&]() { return _closed || can_write(lane); };
+                if (_waiting_writers[lane]++ == 0) _waiting_mask |= (uint64_t(1) << lane);
+                if (ms > 0) {
+                    _not_full[lane].wait_for(lock, std::chrono::milliseconds(ms), ready);
+                } else {
+                    _not_full[lane].wait(lock, ready);
+                }
+                if (--_waiting_writers[lane] == 0) _waiting_mask &= ~(uint64_t(1) << lane);
+            }
+            bool ok = can_write(lane);
+            if (!ok || _size + 1 < _max_size) notify_writer();
+            return ok;
+        }
+
+        // 等待队列有数据，返回false表示非阻塞失败、超时或队列已关闭且取空
+        bool wait_not_empty(std::unique_lock<std::mutex>& lock, int64_t ms) {
+            auto ready = [&]() { return _closed || _ready_mask != 0; };
+            if (ms > 0) {
+                _not_empty.wait_for(lock, std::chrono::milliseconds(ms), ready);
+            } else if (ms < 0) {
+                _not_empty.wait(lock, ready);
+            }
+            return _ready_mask != 0;
+        }
+
+        mutable std::mutex _mtx;
+        std::condition_variable _not_empty;
+        std::condition_variable _not_full[Lanes];  // 每个通道独立的写等待
+        std::list<T> _lanes[Lanes];
+        size_t _waiting_writers[Lanes] = {};       // 各通道阻塞中的写线程数
+        uint64_t _waiting_mask = 0;  // 有写线程等待的通道位图
+        uint64_t _ready_mask = 0;    // 非空通道位图
+        size_t _size = 0;            // 所有通道元素总数
+        size_t _max_size;
+        std::string _name;
+        bool _closed = false;
+};
+
+#endif // __PRIORITY_BUF_LIST_HPP__
@@ -0,0 +1,467 @@
+#include <gtest/gtest.h>
+#include "bufList.hpp"
+#include "priorityBufList.hpp"
+#include "bufListSelector.hpp"
+#include <poll.h>
+#include <thread>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <stdexcept>
+
+// 统计拷贝/移动次数的消息类型
+struct Message {
+    Message() : id(0) {}
+    Message(int i, const std::string& p) : id(i), payload(p) {}
+    Message(const Message& other) : id(other.id), payload(other.payload) { ++copies; }
+    Message(Message&& other) : id(other.id), payload(std::move(other.payload)) { ++moves; }
+    Message& operator=(const Message& other) {
+        id = other.id;
+        payload = other.payload;
+        ++copies;
+        return *this;
+    }
+    Message& operator=(Message&& other) {
+        id = other.id;
+        payload = std::move(other.payload);
+        ++moves;
+        return *this;
+    }
+
+    static void resetCounters() {
+        copies = 0;
+        moves = 0;
+    }
+
+    int id;
+    std::string payload;
+    static int copies;
+    static int moves;
+};
+
+int Message::copies = 0;
+int Message::moves = 0;
+
+TEST(BufListTest, WriteAndRead) {
+    BufList<int> buf(2, "basic");
+    EXPECT_TRUE(buf.write(1));
+    EXPECT_TRUE(buf.write(2));
+    EXPECT_FALSE(buf.write(3));
+    EXPECT_EQ(2u, buf.size());
+
+    int out = 0;
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_EQ(1, out);
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_EQ(2, out);
+    EXPECT_FALSE(buf.read(out));
+}
+
+TEST(BufListTest, ReadTimeout) {
+    BufList<int> buf(1);
+    int out = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(buf.read(out, 20));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+TEST(BufListTest, EmplaceConstructsInPlace) {
+    BufList<Message> buf(4);
+    Message::resetCounters();
+
+    EXPECT_TRUE(buf.emplace(1, "first"));
+    EXPECT_TRUE(buf.try_emplace(0, 2, "second"));
+    EXPECT_EQ(0, Message::copies);
+    EXPECT_EQ(0, Message::moves);
+
+    std::vector<int> ids;
+    EXPECT_TRUE(buf.read_with([&](Message& msg) { ids.push_back(msg.id); }));
+    EXPECT_TRUE(buf.read_with([&](Message& msg) {
+        ids.push_back(msg.id);
+        EXPECT_EQ("second", msg.payload);
+    }));
+    EXPECT_EQ(0, Message::copies);
+    EXPECT_EQ(0, Message::moves);
+    ASSERT_EQ(2u, ids.size());
+    EXPECT_EQ(1, ids[0]);
+    EXPECT_EQ(2, ids[1]);
+}
+
+TEST(BufListTest, TryEmplaceFullTimesOut) {
+    BufList<Message> buf(1);
+    EXPECT_TRUE(buf.try_emplace(0, 1, "a"));
+    EXPECT_FALSE(buf.try_emplace(0, 2, "b"));
+    EXPECT_FALSE(buf.try_emplace(10, 3, "c"));
+    EXPECT_EQ(1u, buf.size());
+}
+
+// 统计构造次数的大消息
+struct BigMessage {
+    explicit BigMessage(size_t n) : payload(n, 'x') { ++constructs; }
+    std::string payload;
+    static int constructs;
+};
+
+int BigMessage::constructs = 0;
+
+TEST(BufListTest, TryEmplaceFullDoesNotConstruct) {
+    BufList<BigMessage> buf(1);
+    BigMessage::constructs = 0;
+    EXPECT_TRUE(buf.try_emplace(0, 1 << 20));
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_FALSE(buf.try_emplace(0, 1 << 20));
+    }
+    EXPECT_EQ(1, BigMessage::constructs);
+    EXPECT_EQ(10u, buf.stats().rejected_writes);
+
+    buf.close();
+    EXPECT_FALSE(buf.try_emplace(0, 1 << 20));
+    EXPECT_EQ(1, BigMessage::constructs);
+}
+
+TEST(BufListTest, ReadWithThrowingCallbackRequeues) {
+    BufList<Message> buf(4);
+    buf.emplace(1, "first");
+    buf.emplace(2, "second");
+
+    EXPECT_THROW(buf.read_with([](Message&) { throw std::runtime_error("fail"); }),
+                 std::runtime_error);
+    EXPECT_EQ(2u, buf.size());
+    EXPECT_EQ(0u, buf.stats().dequeues);
+
+    // 元素保持原位，下次读取仍是队首
+    std::vector<int> ids;
+    EXPECT_TRUE(buf.read_with([&](Message& msg) {
+        ids.push_back(msg.id);
+        EXPECT_EQ("first", msg.payload);
+    }));
+
+    // 关闭后放回的元素仍可读出
+    buf.close();
+    EXPECT_THROW(buf.read_with([](Message&) { throw std::runtime_error("fail"); }),
+                 std::runtime_error);
+    EXPECT_TRUE(buf.read_with([&](Message& msg) { ids.push_back(msg.id); }));
+    EXPECT_FALSE(buf.read_with([&](Message& msg) { ids.push_back(msg.id); }));
+    ASSERT_EQ(2u, ids.size());
+    EXPECT_EQ(1, ids[0]);
+    EXPECT_EQ(2, ids[1]);
+}
+
+TEST(BufListTest, ReadWithEmptyDoesNotCallback) {
+    BufList<int> buf(1);
+    bool called = false;
+    EXPECT_FALSE(buf.read_with([&](int&) { called = true; }));
+    EXPECT_FALSE(buf.read_with([&](int&) { called = true; }, 10));
+    EXPECT_FALSE(called);
+}
+
+TEST(BufListTest, ProducerConsumer) {
+    const int count = 10000;
+    BufList<Message> buf(16);
+    std::atomic<long long> sum(0);
+
+    std::thread consumer([&]() {
+        for (int i = 0; i < count; ++i) {
+            buf.read_with([&](Message& msg) { sum += msg.id; }, -1);
+        }
+    });
+    std::thread producer([&]() {
+        for (int i = 0; i < count; ++i) {
+            buf.emplace(i, "payload");
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    EXPECT_EQ(static_cast<long long>(count) * (count - 1) / 2, sum.load());
+    EXPECT_EQ(0u, buf.size());
+}
+
+TEST(BufListTest, CloseRejectsWritesAndDrainsReads) {
+    BufList<int> buf(4);
+    EXPECT_TRUE(buf.write(1));
+    EXPECT_TRUE(buf.write(2));
+    buf.close();
+    EXPECT_TRUE(buf.is_closed());
+    EXPECT_FALSE(buf.write(3));
+    EXPECT_FALSE(buf.emplace(4));
+
+    int out = 0;
+    EXPECT_TRUE(buf.read(out, -1));
+    EXPECT_EQ(1, out);
+    EXPECT_TRUE(buf.read(out, -1));
+    EXPECT_EQ(2, out);
+    // 取空后永久阻塞的读也立即返回
+    EXPECT_FALSE(buf.read(out, -1));
+}
+
+TEST(BufListTest, CloseWakesAllBlockedThreads) {
+    BufList<int> empty_buf(1);
+    BufList<int> full_buf(1);
+    full_buf.write(0);
+
+    const int waiters = 8;
+    std::atomic<int> woken(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < waiters; ++i) {
+        threads.emplace_back([&]() {
+            int out = 0;
+            if (!empty_buf.read(out, -1)) ++woken;
+        });
+        threads.emplace_back([&]() {
+            if (!full_buf.write(1, -1)) ++woken;
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    empty_buf.close();
+    full_buf.close();
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(waiters * 2, woken.load());
+}
+
+TEST(BufListTest, StatsCounters) {
+    BufList<int> buf(2, "stats");
+    EXPECT_TRUE(buf.write(1));
+    EXPECT_TRUE(buf.write(2));
+    EXPECT_FALSE(buf.write(3));
+    EXPECT_FALSE(buf.write(3, 5));
+
+    int out = 0;
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_FALSE(buf.read(out, 5));
+
+    BufListStats st = buf.stats();
+    EXPECT_EQ("stats", st.name);
+    EXPECT_EQ(0u, st.size);
+    EXPECT_EQ(2u, st.max_size);
+    EXPECT_EQ(2u, st.high_water);
+    EXPECT_EQ(2u, st.enqueues);
+    EXPECT_EQ(2u, st.dequeues);
+    EXPECT_EQ(2u, st.rejected_writes);
+    EXPECT_EQ(1u, st.write_timeouts);
+    EXPECT_EQ(1u, st.read_timeouts);
+    EXPECT_GT(st.producer_blocked_ns, 0u);
+    EXPECT_GT(st.consumer_blocked_ns, 0u);
+    // 第一个元素总会被采样
+    EXPECT_EQ(1u, st.sojourn_samples);
+
+    buf.reset_stats();
+    st = buf.stats();
+    EXPECT_EQ(0u, st.enqueues);
+    EXPECT_EQ(0u, st.rejected_writes);
+    EXPECT_EQ(0u, st.sojourn_samples);
+}
+
+TEST(BufListTest, SojournSamplingSurvivesClear) {
+    BufList<int> buf(1000);
+    for (int i = 0; i < 100; ++i) buf.write(i);
+    buf.clear();
+    for (int i = 0; i < 200; ++i) buf.write(i);
+    int out = 0;
+    while (buf.read(out)) {}
+
+    BufListStats st = buf.stats();
+    EXPECT_EQ(300u, st.enqueues);
+    EXPECT_EQ(200u, st.dequeues);
+    // 序号 128、192、256 处的采样属于第二批写入
+    EXPECT_EQ(3u, st.sojourn_samples);
+    EXPECT_GE(st.sojourn_max_ns, static_cast<uint64_t>(st.avg_sojourn_ns()));
+}
+
+TEST(BufListSelectorTest, ReturnsReadyQueue) {
+    BufList<int> a(4, "a");
+    BufList<std::string> b(4, "b");
+    BufListSelector sel;
+    EXPECT_EQ(0u, sel.add(a));
+    EXPECT_EQ(1u, sel.add(b));
+
+    EXPECT_EQ(-1, sel.select(0));
+    EXPECT_EQ(-1, sel.select(10));
+
+    b.write("hello");
+    EXPECT_EQ(1, sel.select(0));
+    std::string s;
+    EXPECT_TRUE(b.read(s));
+    EXPECT_EQ(-1, sel.select(0));
+}
+
+TEST(BufListSelectorTest, WakesOnWriteAndClose) {
+    BufList<int> a(4);
+    BufList<int> b(4);
+    BufListSelector sel;
+    sel.add(a);
+    sel.add(b);
+
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        b.write(7);
+    });
+    EXPECT_EQ(1, sel.select(-1));
+    producer.join();
+
+    int out = 0;
+    b.read(out);
+    EXPECT_EQ(7, out);
+
+    std::thread closer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        a.close();
+    });
+    EXPECT_EQ(0, sel.select(1000));
+    closer.join();
+}
+
+TEST(BufListSelectorTest, RoundRobinWhenAllReady) {
+    BufList<int> a(4);
+    BufList<int> b(4);
+    BufListSelector sel;
+    sel.add(a);
+    sel.add(b);
+    a.write(1);
+    b.write(2);
+    EXPECT_EQ(0, sel.select(0));
+    EXPECT_EQ(1, sel.select(0));
+    EXPECT_EQ(0, sel.select(0));
+}
+
+TEST(BufListTest, EventFdTracksReadableState) {
+    BufList<int> buf(4);
+    int fd = buf.event_fd();
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(fd, buf.event_fd());
+
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    EXPECT_EQ(0, ::poll(&pfd, 1, 0));
+
+    buf.write(1);
+    buf.write(2);
+    EXPECT_EQ(1, ::poll(&pfd, 1, 0));
+
+    int out = 0;
+    buf.read(out);
+    EXPECT_EQ(1, ::poll(&pfd, 1, 0));
+    buf.read(out);
+    EXPECT_EQ(0, ::poll(&pfd, 1, 0));
+
+    buf.close();
+    EXPECT_EQ(1, ::poll(&pfd, 1, 0));
+}
+
+TEST(PriorityBufListTest, HighestLaneFirst) {
+    PriorityBufList<int, 3> buf(16);
+    EXPECT_TRUE(buf.write(2, 20));
+    EXPECT_TRUE(buf.write(2, 21));
+    EXPECT_TRUE(buf.write(1, 10));
+    EXPECT_TRUE(buf.write(0, 0));
+    EXPECT_EQ(4u, buf.size());
+    EXPECT_EQ(2u, buf.size(2));
+
+    int out = -1;
+    size_t lane = 99;
+    EXPECT_TRUE(buf.read(out, 0, &lane));
+    EXPECT_EQ(0, out);
+    EXPECT_EQ(0u, lane);
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_EQ(10, out);
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_EQ(20, out);
+    // 低优先级通道读取期间插入高优先级数据，应被先取出
+    EXPECT_TRUE(buf.write(0, 1));
+    EXPECT_TRUE(buf.read(out));
+    EXPECT_EQ(1, out);
+    EXPECT_TRUE(buf.read_with([&](int& v, size_t l) {
+        EXPECT_EQ(21, v);
+        EXPECT_EQ(2u, l);
+    }));
+    EXPECT_FALSE(buf.read(out));
+}
+
+TEST(PriorityBufListTest, SharedCapacity) {
+    PriorityBufList<int, 2> buf(2);
+    EXPECT_TRUE(buf.write(1, 1));
+    EXPECT_TRUE(buf.write(1, 2));
+    EXPECT_FALSE(buf.write(0, 3));
+    EXPECT_FALSE(buf.try_emplace(0, 10, 3));
+    EXPECT_THROW(buf.write(2, 4), std::out_of_range);
+}
+
+TEST(PriorityBufListTest, BlockedControlWriterNotStarved) {
+    PriorityBufList<int, 2> buf(1);
+    ASSERT_TRUE(buf.write(1, -1));
+
+    // 队列已满，大量批量写线程阻塞在 lane 1
+    const int bulk_writers = 16;
+    std::vector<std::thread> bulk;
+    for (int i = 0; i < bulk_writers; ++i) {
+        bulk.emplace_back([&buf, i]() { buf.write(1, i, -1); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // 控制写线程随后阻塞在 lane 0，空出的第一个位置必须留给它
+    std::atomic<bool> control_done(false);
+    std::thread control([&]() {
+        EXPECT_TRUE(buf.write(0, 1000, -1));
+        control_done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(control_done);
+
+    int out = 0;
+    size_t lane = 99;
+    EXPECT_TRUE(buf.read(out, -1));
+    EXPECT_EQ(-1, out);
+    EXPECT_TRUE(buf.read(out, -1, &lane));
+    EXPECT_EQ(1000, out);
+    EXPECT_EQ(0u, lane);
+
+    // 批量写线程随后依次写入
+    for (int i = 0; i < bulk_writers; ++i) {
+        EXPECT_TRUE(buf.read(out, 2000, &lane));
+        EXPECT_EQ(1u, lane);
+    }
+    control.join();
+    for (auto& t : bulk) t.join();
+    EXPECT_EQ(0u, buf.size());
+}
+
+TEST(PriorityBufListTest, WaitingControlWriterBlocksBulkAdmission) {
+    PriorityBufList<int, 2> buf(1);
+    ASSERT_TRUE(buf.write(1, 1));
+    std::thread control([&]() { EXPECT_TRUE(buf.write(0, 0, 2000)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // 控制通道等待期间，腾出的空位不允许批量通道的非阻塞写入占用
+    int out = 0;
+    ASSERT_TRUE(buf.read(out));
+    EXPECT_FALSE(buf.write(1, 2));
+    control.join();
+    EXPECT_EQ(1u, buf.size(0));
+    EXPECT_EQ(0u, buf.size(1));
+}
+
+TEST(PriorityBufListTest, CloseDrainsAllLanes) {
+    PriorityBufList<int, 2> buf(4);
+    buf.write(1, 1);
+    buf.write(0, 0);
+
+    std::vector<int> got;
+    std::thread reader([&]() {
+        int v = 0;
+        while (buf.read(v, -1)) got.push_back(v);
+    });
+    buf.close();
+    reader.join();
+    EXPECT_FALSE(buf.write(0, 5));
+    ASSERT_EQ(2u, got.size());
+    EXPECT_EQ(0, got[0]);
+    EXPECT_EQ(1, got[1]);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "jsonDom.h"
+#include "jsonParser.h"
+#include <string>
+#include <vector>
+
+TEST(JsonArenaTest, AllocateAlignAndReset) {
+    JsonArena arena(256);
+    char* a = static_cast<char*>(arena.allocate(3, 1));
+    void* b = arena.allocate(sizeof(double), alignof(double));
+    EXPECT_NE(nullptr, a);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b) % alignof(double));
+
+    // 超过块大小的分配单独占一块
+    void* big = arena.allocate(4096, 8);
+    EXPECT_NE(nullptr, big);
+    size_t reserved = arena.bytesReserved();
+
+    // reset 后复用已有的块，不再申请
+    arena.reset();
+    EXPECT_EQ(0u, arena.bytesUsed());
+    for (int i = 0; i < 10; ++i) {
+        arena.allocate(16, 8);
+    }
+    EXPECT_EQ(reserved, arena.bytesReserved());
+}
+
+TEST(JsonDocumentTest, ParseScalarsAndContainers) {
+    std::string json = R"( {"name":"craftrix","ok":true,"none":null,"n":-12.5e1,"i":42,
+                            "list":[1,"two",false,[],{}],"nested":{"a":{"b":[3]}}} )";
+    JsonDocument doc;
+    ASSERT_TRUE(doc.parse(json.data(), json.size())) << doc.error();
+
+    const JsonValue* root = doc.root();
+    ASSERT_NE(nullptr, root);
+    ASSERT_TRUE(root->isObject());
+    EXPECT_EQ(7u, root->size());
+
+    EXPECT_EQ("craftrix", root->find("name")->getString());
+    EXPECT_TRUE(root->find("ok")->asBool());
+    EXPECT_TRUE(root->find("none")->isNull());
+    EXPECT_DOUBLE_EQ(-125.0, root->find("n")->asDouble());
+    EXPECT_EQ(42, root->find("i")->asInt64());
+    EXPECT_EQ("42", root->find("i")->rawNumber().toString());
+    EXPECT_EQ(nullptr, root->find("missing"));
+
+    const JsonValue* list = root->find("list");
+    ASSERT_TRUE(list->isArray());
+    ASSERT_EQ(5u, list->size());
+    EXPECT_EQ(1, list->at(0)->asInt64());
+    EXPECT_EQ("two", list->at(1)->getString());
+    EXPECT_FALSE(list->at(2)->asBool());
+    EXPECT_TRUE(list->at(3)->isArray() && list->at(3)->empty());
+    EXPECT_TRUE(list->at(4)->isObject() && list->at(4)->empty());
+    EXPECT_EQ(nullptr, list->at(5));
+
+    const JsonValue* b = root->find("nested")->find("a")->find("b");
+    ASSERT_NE(nullptr, b);
+    EXPECT_EQ(3, b->at(0)->asInt64());
+
+    // 成员按原顺序迭代
+    std::vector<std::string> keys;
+    for (const JsonValue& member : *root) {
+        keys.push_back(member.getKey());
+    }
+    std::vector<std::string> expected = {"name", "ok", "none", "n", "i", "list", "nested"};
+    EXPECT_EQ(expected, keys);
+}
+
+TEST(JsonDocumentTest, StringsAreViewsIntoSource) {
+    std::string json = R"({"plain":"abc","esc":"a\"b\\c\n\u00e9\ud83d\ude00"})";
+    JsonDocument doc;
+    ASSERT_TRUE(doc.parse(json.data(), json.size()));
+
+    const JsonValue* plain = doc.root()->find("plain");
+    EXPECT_FALSE(plain->hasEscape());
+    std::string scratch;
+    JsonView view = plain->stringView(scratch);
+    // 无转义的字符串直接指向源缓冲区
+    EXPECT_GE(view.data, json.data());
+    EXPECT_LT(view.data, json.data() + json.size());
+    EXPECT_TRUE(scratch.empty());
+
+    const JsonValue* esc = doc.root()->find("esc");
+    EXPECT_TRUE(esc->hasEscape());
+    EXPECT_EQ("a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00", esc->rawString().toString());
+    EXPECT_EQ("a\"b\\c\n\xc3\xa9\xf0\x9f\x98\x80", esc->getString());
+}
+
+TEST(JsonDocumentTest, EscapedKeysAreMatchedUnescaped) {
+    std::string json = R"({"a\"b":1,"c\u0064":2})";
+    JsonDocument doc;
+    ASSERT_TRUE(doc.parse(json.data(), json.size()));
+    EXPECT_EQ(1, doc.root()->find("a\"b")->asInt64());
+    EXPECT_EQ(2, doc.root()->find("cd")->asInt64());
+}
+
+TEST(JsonDocumentTest, RejectsInvalidJson) {
+    const char* bad[] = {
+        "", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "[01]", "[1.]", "[-]", "[1e]",
+        "tru", "nul", "\"abc", "\"a\\x\"", "\"\\u12g4\"", "\"a\tb\"", "{} []", "{1:2}", "[1 2]"
+    };
+    JsonDocument doc;
+    for (const char* text : bad) {
+        EXPECT_FALSE(doc.parse(text, std::strlen(text))) << text;
+        EXPECT_FALSE(doc.error().empty()) << text;
+        EXPECT_EQ(nullptr, doc.root());
+    }
+
+    std::string json = "{\"a\":[1,2,x]}";
+    EXPECT_FALSE(doc.parse(json.data(), json.size()));
+    EXPECT_EQ(json.find('x'), doc.errorOffset());
+}
+
+TEST(JsonDocumentTest, DepthLimit) {
+    std::string deep(100, '[');
+    deep += std::string(100, ']');
+    JsonDocument shallow(4096, 50);
+    EXPECT_FALSE(shallow.parse(deep.data(), deep.size()));
+
+    JsonDocument doc(4096, 512);
+    EXPECT_TRUE(doc.parse(deep.data(), deep.size()));
+}
+
+TEST(JsonDocumentTest, ReparseReusesArena) {
+    std::string json = "{\"items\":[";
+    for (int i = 0; i < 1000; ++i) {
+        if (i) json += ',';
+        json += "{\"id\":" + std::to_string(i) + ",\"tag\":\"t\"}";
+    }
+    json += "]}";
+
+    JsonDocument doc(4096);
+    ASSERT_TRUE(doc.parse(json.data(), json.size()));
+    EXPECT_EQ(1000u, doc.root()->find("items")->size());
+    size_t used = doc.memoryUsed();
+    EXPECT_GT(used, 0u);
+
+    // 重复解析时用量不增长，旧树一次性释放
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(doc.parse(json.data(), json.size()));
+        EXPECT_EQ(used, doc.memoryUsed());
+    }
+    doc.clear();
+    EXPECT_EQ(0u, doc.memoryUsed());
+    EXPECT_EQ(nullptr, doc.root());
+}
+
+TEST(JsonDocumentTest, ParseFramesFromRingBuffer) {
+    // 小缓冲区迫使帧在环形缓冲区中回绕
+    std::vector<int64_t> ids;
+    JsonDocument doc;
+    auto parser = JsonParserFactory::createViewParser(
+        JsonParserFactory::ParserType::RING_BUFFER,
+        [&](const JsonFrame& frame) {
+            ASSERT_TRUE(doc.parse(frame)) << doc.error();
+            ids.push_back(doc.root()->find("id")->asInt64());
+        },
+        nullptr, 64);
+
+    for (int i = 0; i < 50; ++i) {
+        parser->addData("{\"id\":" + std::to_string(i) + ",\"pad\":\"xxxxxxxxxxxx\"}\n");
+    }
+    ASSERT_EQ(50u, ids.size());
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(i, ids[i]);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
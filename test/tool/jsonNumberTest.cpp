@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "jsonNumber.h"
+#include "jsonDom.h"
+#include "jsonSax.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static JsonNumber parseNumber(const std::string& text) {
+    JsonNumber number;
+    EXPECT_TRUE(JsonNumberParser::parse(text.data(), text.size(), number)) << text;
+    return number;
+}
+
+static uint64_t bitsOf(double d) {
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+TEST(JsonNumberParserTest, EightDigitSwar) {
+    EXPECT_TRUE(JsonNumberParser::isEightDigits("12345678"));
+    EXPECT_FALSE(JsonNumberParser::isEightDigits("1234567a"));
+    EXPECT_FALSE(JsonNumberParser::isEightDigits("1234.678"));
+    EXPECT_EQ(12345678u, JsonNumberParser::parseEightDigits("12345678"));
+    EXPECT_EQ(0u, JsonNumberParser::parseEightDigits("00000000"));
+    EXPECT_EQ(99999999u, JsonNumberParser::parseEightDigits("99999999"));
+    EXPECT_EQ(1u, JsonNumberParser::parseEightDigits("00000001"));
+}
+
+TEST(JsonNumberParserTest, Integers) {
+    JsonNumber n = parseNumber("0");
+    EXPECT_EQ(JsonNumberType::Int64, n.type);
+    EXPECT_EQ(0, n.i);
+
+    EXPECT_EQ(-42, parseNumber("-42").i);
+    EXPECT_EQ(1234567890123456789LL, parseNumber("1234567890123456789").i);
+    EXPECT_EQ(INT64_MAX, parseNumber("9223372036854775807").i);
+    EXPECT_EQ(INT64_MIN, parseNumber("-9223372036854775808").i);
+
+    n = parseNumber("9223372036854775808");
+    EXPECT_EQ(JsonNumberType::UInt64, n.type);
+    EXPECT_EQ(9223372036854775808ULL, n.u);
+
+    n = parseNumber("18446744073709551615");
+    EXPECT_EQ(JsonNumberType::UInt64, n.type);
+    EXPECT_EQ(UINT64_MAX, n.u);
+
+    // 超出64位整数范围转为浮点
+    n = parseNumber("18446744073709551616");
+    EXPECT_EQ(JsonNumberType::Double, n.type);
+    EXPECT_DOUBLE_EQ(18446744073709551616.0, n.d);
+
+    n = parseNumber("-9223372036854775809");
+    EXPECT_EQ(JsonNumberType::Double, n.type);
+}
+
+TEST(JsonNumberParserTest, InvalidSyntax) {
+    const char* bad[] = {"", "-", "+1", "01", "1.", ".5", "1e", "1e+", "1.e5", "0x10", "1 ", " 1", "--1", "1..2", "1e5.0", "NaN", "Infinity"};
+    for (const char* text : bad) {
+        JsonNumber n;
+        EXPECT_FALSE(JsonNumberParser::parse(text, std::strlen(text), n)) << text;
+    }
+}
+
+TEST(JsonNumberParserTest, DoublesMatchStrtod) {
+    const char* cases[] = {
+        "0.0", "-0.0", "1.5", "3.141592653589793", "2.2250738585072014e-308", "2.2250738585072011e-308",
+        "4.9406564584124654e-324", "1.7976931348623157e308", "1e309", "-1e309", "1e-400", "5e-324",
+        "9007199254740993.0", "1e23", "8.98846567431158e307", "0.1", "0.3",
+        "123456789012345678901234567890", "0.000000000000000000000000000001234567890123456789012345",
+        "2.9802322387695312e-8", "7.2057594037927933e16", "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203124", "1.00000000000000011102230246251565404236316680908203126",
+        "9.109e-31", "6.02214076e23", "1E2", "1e+2", "1e-2", "100e-2"
+    };
+    for (const char* text : cases) {
+        JsonNumber n = parseNumber(text);
+        ASSERT_EQ(JsonNumberType::Double, n.type) << text;
+        EXPECT_EQ(bitsOf(std::strtod(text, nullptr)), bitsOf(n.d)) << text;
+    }
+}
+
+TEST(JsonNumberParserTest, RandomDoublesRoundTrip) {
+    std::mt19937_64 rng(42);
+    char buf[64];
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t bits = rng();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (d != d || d - d != 0) continue;   // 跳过 NaN 与无穷
+        int precision = 1 + static_cast<int>(rng() % 17);
+        std::snprintf(buf, sizeof(buf), "%.*e", precision, d);
+        JsonNumber n;
+        ASSERT_TRUE(JsonNumberParser::parse(buf, std::strlen(buf), n)) << buf;
+        ASSERT_EQ(bitsOf(std::strtod(buf, nullptr)), bitsOf(n.toDouble())) << buf;
+    }
+}
+
+TEST(JsonNumberParserTest, RandomDecimalStrings) {
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 200000; ++i) {
+        std::string text;
+        if (rng() % 2) text += '-';
+        int int_digits = 1 + static_cast<int>(rng() % 20);
+        text += static_cast<char>('1' + rng() % 9);
+        for (int k = 1; k < int_digits; ++k) text += static_cast<char>('0' + rng() % 10);
+        int frac_digits = static_cast<int>(rng() % 20);
+        if (frac_digits) {
+            text += '.';
+            for (int k = 0; k < frac_digits; ++k) text += static_cast<char>('0' + rng() % 10);
+        }
+        if (rng() % 2) {
+            text += 'e';
+            text += std::to_string(static_cast<int>(rng() % 700) - 350);
+        }
+        JsonNumber n;
+        ASSERT_TRUE(JsonNumberParser::parse(text.data(), text.size(), n)) << text;
+        if (n.type == JsonNumberType::Double) {
+            ASSERT_EQ(bitsOf(std::strtod(text.c_str(), nullptr)), bitsOf(n.d)) << text;
+        } else if (n.type == JsonNumberType::Int64) {
+            ASSERT_EQ(std::strtoll(text.c_str(), nullptr, 10), n.i) << text;
+        } else {
+            ASSERT_EQ(std::strtoull(text.c_str(), nullptr, 10), n.u) << text;
+        }
+    }
+}
+
+TEST(JsonNumberParserTest, DomKeepsIntegersAndDoublesDistinct) {
+    std::string json = R"([1,-2,18446744073709551615,1.0,2e3,-0.5])";
+    JsonDocument doc;
+    ASSERT_TRUE(doc.parse(json.data(), json.size()));
+    const JsonValue* root = doc.root();
+    EXPECT_EQ(JsonType::Int64, root->at(0)->type());
+    EXPECT_EQ(JsonType::Int64, root->at(1)->type());
+    EXPECT_EQ(JsonType::UInt64, root->at(2)->type());
+    EXPECT_EQ(UINT64_MAX, root->at(2)->asUInt64());
+    EXPECT_EQ(JsonType::Double, root->at(3)->type());
+    EXPECT_EQ(JsonType::Double, root->at(4)->type());
+    EXPECT_DOUBLE_EQ(2000.0, root->at(4)->asDouble());
+    EXPECT_DOUBLE_EQ(-0.5, root->at(5)->asDouble());
+    EXPECT_TRUE(root->at(0)->isInteger());
+    EXPECT_TRUE(root->at(3)->isNumber());
+    EXPECT_FALSE(root->at(3)->isInteger());
+}
+
+TEST(JsonNumberParserTest, SaxDispatchesByType) {
+    class Collector : public JsonSaxHandler {
+        public:
+            bool int64Value(int64_t v) override { ints.push_back(v); return true; }
+            bool uint64Value(uint64_t v) override { uints.push_back(v); return true; }
+            bool doubleValue(double v) override { doubles.push_back(v); return true; }
+            std::vector<int64_t> ints;
+            std::vector<uint64_t> uints;
+            std::vector<double> doubles;
+    } collector;
+    JsonSaxParser parser(collector);
+    parser.addData("[7,-8,9223372036854775808,0.25,1e2]");
+    EXPECT_EQ((std::vector<int64_t>{7, -8}), collector.ints);
+    EXPECT_EQ((std::vector<uint64_t>{9223372036854775808ULL}), collector.uints);
+    EXPECT_EQ((std::vector<double>{0.25, 100.0}), collector.doubles);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
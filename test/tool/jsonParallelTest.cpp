@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include "jsonParallel.h"
+#include "jsonParser.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+// 生成带有括号、引号和转义的随机字符串，用来制造跨段边界的难例
+static std::string randomString(std::mt19937& rng) {
+    static const char alphabet[] = "ab{}[]\\\" ,:";
+    std::string s = "\"";
+    size_t len = rng() % 40;
+    for (size_t i = 0; i < len; ++i) {
+        char c = alphabet[rng() % (sizeof(alphabet) - 1)];
+        if (c == '\\' || c == '"') {
+            s += '\\';
+        }
+        s += c;
+    }
+    // 偶尔以连续反斜杠结尾
+    if (rng() % 5 == 0) s += "\\\\\\\\";
+    s += '"';
+    return s;
+}
+
+static std::string randomMessage(std::mt19937& rng, int depth = 0) {
+    std::string m;
+    if (depth < 3 && rng() % 3 == 0) {
+        m += '[';
+        size_t n = rng() % 4;
+        for (size_t i = 0; i < n; ++i) {
+            if (i) m += ',';
+            m += randomMessage(rng, depth + 1);
+        }
+        m += ']';
+    } else {
+        m += '{';
+        size_t n = rng() % 4;
+        for (size_t i = 0; i < n; ++i) {
+            if (i) m += ',';
+            m += randomString(rng) + ":";
+            m += (depth < 3 && rng() % 2) ? randomMessage(rng, depth + 1) : randomString(rng);
+        }
+        m += '}';
+    }
+    return m;
+}
+
+static std::vector<std::string> sequentialFrames(const std::string& data) {
+    std::vector<std::string> frames;
+    auto parser = JsonParserFactory::createParser(JsonParserFactory::ParserType::INCREMENTAL,
+        [&](const std::string& json) {
+            frames.push_back(json);
+        });
+    parser->addData(data);
+    return frames;
+}
+
+struct Collected {
+    std::mutex mutex;
+    std::vector<std::pair<uint64_t, std::string>> frames;
+};
+
+static std::vector<std::string> parallelFrames(const std::string& data, size_t threads, JsonParallelFramer::Delivery delivery,
+                                               JsonParallelResult* result = nullptr) {
+    Collected collected;
+    JsonParallelFramer framer([&](const JsonView& json, uint64_t seq) {
+        std::lock_guard<std::mutex> lock(collected.mutex);
+        collected.frames.push_back(std::make_pair(seq, json.toString()));
+    }, nullptr, threads, 64);
+    JsonParallelResult r = framer.frame(data, delivery);
+    if (result) *result = r;
+
+    if (delivery == JsonParallelFramer::Delivery::Ordered) {
+        for (size_t i = 0; i < collected.frames.size(); ++i) {
+            EXPECT_EQ(i, collected.frames[i].first);
+        }
+    }
+    std::sort(collected.frames.begin(), collected.frames.end());
+    std::vector<std::string> frames;
+    for (auto& f : collected.frames) {
+        frames.push_back(f.second);
+    }
+    return frames;
+}
+
+TEST(JsonParallelFramerTest, MatchesSequentialFraming) {
+    std::mt19937 rng(17);
+    for (int round = 0; round < 50; ++round) {
+        std::string data;
+        size_t count = 1 + rng() % 200;
+        for (size_t i = 0; i < count; ++i) {
+            data += randomMessage(rng);
+            data += (rng() % 2) ? "\n" : " \r\n";
+        }
+        std::vector<std::string> expected = sequentialFrames(data);
+        ASSERT_EQ(count, expected.size());
+
+        for (size_t threads : {1, 2, 3, 7, 16}) {
+            JsonParallelResult result;
+            EXPECT_EQ(expected, parallelFrames(data, threads, JsonParallelFramer::Delivery::Ordered, &result))
+                << "threads=" << threads << " round=" << round;
+            EXPECT_EQ(count, result.messages);
+            EXPECT_EQ(data.find_last_not_of(" \r\n") + 1, result.consumed);
+            EXPECT_EQ(expected, parallelFrames(data, threads, JsonParallelFramer::Delivery::Unordered))
+                << "threads=" << threads << " round=" << round;
+        }
+    }
+}
+
+TEST(JsonParallelFramerTest, SegmentBoundaryInsideStringAndEscape) {
+    // 让段边界（64字节对齐）恰好落在字符串内部、转义序列中间以及消息之间
+    for (size_t pad = 0; pad < 80; ++pad) {
+        std::string data = "{\"k\":\"" + std::string(pad, 'x') + "\\\\\\\"}]{[\"}\n";
+        data += "[\"" + std::string(pad % 13, '\\') + std::string(pad % 13, '\\') + "\",{\"a\":[]}]\n";
+        data += "{\"tail\":\"" + std::string(100, '{') + "\"}";
+        std::vector<std::string> expected = sequentialFrames(data);
+        ASSERT_EQ(3u, expected.size());
+        for (size_t threads : {2, 3, 4}) {
+            EXPECT_EQ(expected, parallelFrames(data, threads, JsonParallelFramer::Delivery::Ordered)) << "pad=" << pad;
+        }
+    }
+}
+
+TEST(JsonParallelFramerTest, SingleLargeDocument) {
+    // 一个跨越所有段的大数组：除起始段外各段都从消息内部开始，不应交付任何消息
+    std::mt19937 rng(29);
+    std::string doc = "[";
+    for (int i = 0; i < 2000; ++i) {
+        if (i) doc += ',';
+        doc += randomMessage(rng);
+    }
+    doc += "]";
+    std::string data = "{\"head\":1}\n" + doc + "\n{\"tail\":[\"]\"]}\n";
+    std::vector<std::string> expected = sequentialFrames(data);
+    ASSERT_EQ(3u, expected.size());
+    for (size_t threads : {1, 2, 4, 8}) {
+        JsonParallelResult result;
+        EXPECT_EQ(expected, parallelFrames(data, threads, JsonParallelFramer::Delivery::Ordered, &result))
+            << "threads=" << threads;
+        EXPECT_EQ(3u, result.messages);
+        EXPECT_EQ(expected, parallelFrames(data, threads, JsonParallelFramer::Delivery::Unordered));
+    }
+}
+
+TEST(JsonParallelFramerTest, TrailingPartialMessageNotDelivered) {
+    std::string data;
+    for (int i = 0; i < 100; ++i) {
+        data += "{\"i\":" + std::to_string(i) + ",\"s\":\"[{\"}\n";
+    }
+    size_t complete = data.size() - 1;
+    data += "{\"partial\":[1,2";
+    JsonParallelResult result;
+    std::vector<std::string> frames = parallelFrames(data, 4, JsonParallelFramer::Delivery::Ordered, &result);
+    EXPECT_EQ(100u, frames.size());
+    EXPECT_EQ(100u, result.messages);
+    EXPECT_EQ(complete, result.consumed);
+    EXPECT_FALSE(result.complete);
+
+    // 末尾只有空白时 complete 为真
+    JsonParallelResult whole;
+    parallelFrames(data.substr(0, complete + 1), 4, JsonParallelFramer::Delivery::Ordered, &whole);
+    EXPECT_TRUE(whole.complete);
+}
+
+TEST(JsonParallelFramerTest, MalformedInputReported) {
+    std::string messages;
+    for (int i = 0; i < 100; ++i) {
+        messages += "{\"i\":" + std::to_string(i) + ",\"s\":\"[{\"}\n";
+    }
+    for (size_t threads : {1, 4}) {
+        std::vector<std::string> errors;
+        size_t delivered = 0;
+        JsonParallelFramer framer([&](const JsonView&, uint64_t) {
+            ++delivered;
+        }, [&](const std::string& error) {
+            errors.push_back(error);
+        }, threads, 64);
+
+        // 多余的结束括号
+        JsonParallelResult result = framer.frame(messages + "]]\n" + messages);
+        EXPECT_EQ(200u, result.messages);
+        EXPECT_EQ(1u, errors.size());
+
+        // 消息之外未结束的字符串
+        errors.clear();
+        result = framer.frame(messages + "\"dangling");
+        EXPECT_EQ(100u, result.messages);
+        EXPECT_FALSE(result.complete);
+        EXPECT_EQ(1u, errors.size());
+
+        // 末尾未结束的消息不是错误，留给下一批
+        errors.clear();
+        result = framer.frame(messages + "{\"a\":\"x");
+        EXPECT_FALSE(result.complete);
+        EXPECT_TRUE(errors.empty());
+    }
+}
+
+TEST(JsonParallelFramerTest, CallbackExceptionReported) {
+    std::string data = "{\"a\":1}\n{\"a\":2}\n{\"a\":3}\n";
+    std::vector<std::string> errors;
+    size_t delivered = 0;
+    JsonParallelFramer framer([&](const JsonView&, uint64_t seq) {
+        ++delivered;
+        if (seq == 1) throw std::runtime_error("bad message");
+    }, [&](const std::string& error) {
+        errors.push_back(error);
+    }, 2, 64);
+    framer.frame(data);
+    EXPECT_EQ(3u, delivered);
+    ASSERT_EQ(1u, errors.size());
+    EXPECT_EQ("bad message", errors[0]);
+}
+
+TEST(JsonParallelFramerTest, ParseFile) {
+    std::mt19937 rng(23);
+    std::string data;
+    for (int i = 0; i < 500; ++i) {
+        data += randomMessage(rng) + "\n";
+    }
+    std::string path = "jsonParallelTest.ndjson";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << data;
+    }
+    std::vector<std::string> frames;
+    JsonParallelFramer framer([&](const JsonView& json, uint64_t) {
+        frames.push_back(json.toString());
+    }, nullptr, 4, 256);
+    JsonParallelResult result;
+    ASSERT_TRUE(framer.parseFile(path, JsonParallelFramer::Delivery::Ordered, &result));
+    EXPECT_EQ(sequentialFrames(data), frames);
+    EXPECT_EQ(500u, result.messages);
+    std::remove(path.c_str());
+
+    std::vector<std::string> errors;
+    JsonParallelFramer missing([](const JsonView&, uint64_t) {}, [&](const std::string& error) {
+        errors.push_back(error);
+    });
+    EXPECT_FALSE(missing.parseFile("/nonexistent/file.ndjson"));
+    EXPECT_EQ(1u, errors.size());
+
+    // 文件末尾的消息不完整
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << data << "{\"tail\":[1,";
+    }
+    errors.clear();
+    frames.clear();
+    JsonParallelFramer truncated([&](const JsonView& json, uint64_t) {
+        frames.push_back(json.toString());
+    }, [&](const std::string& error) {
+        errors.push_back(error);
+    }, 4, 256);
+    ASSERT_TRUE(truncated.parseFile(path, JsonParallelFramer::Delivery::Ordered, &result));
+    EXPECT_EQ(500u, frames.size());
+    EXPECT_FALSE(result.complete);
+    EXPECT_EQ(1u, errors.size());
+    std::remove(path.c_str());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,552 @@
+// JSON 分帧吞吐基准
+//
+// 生成几类有代表性的语料，对每种解析器、每种 addData 分块方式测量 MB/s 与 msg/s；
+// 另有编解码微基准，在同一输入上对比本库的数字解析/写入与 strtod/ostringstream。
+// 结果打印成表格，并可用 --out 写成 JSON 供回归对比。
+//
+// 用法: jsonParserBench [--quick] [--out result.json] [--suite 名称] [--corpus 名称] [--parser 名称] [--min-time 秒]
+//   --quick      语料缩小、每项只跑一次，用于冒烟测试
+//   --suite      只跑指定部分：framing / codec
+//   --corpus     只跑指定语料：small / nested / logs / telemetry
+//   --parser     只跑指定解析器：incremental / ring_buffer / ndjson / length_prefixed / json_seq
+//   --min-time   每项至少运行的时间，默认 0.3 秒
+// 交付的消息数与语料不符、或编解码结果校验失败时返回非 0。
+
+#include "jsonParser.h"
+#include "jsonWriter.h"
+#include "jsonNumber.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ParserType = JsonParserFactory::ParserType;
+
+struct Corpus {
+    std::string name;
+    std::vector<std::string> messages;
+};
+
+struct ParserEntry {
+    const char* name;
+    ParserType type;
+};
+
+const ParserEntry kParsers[] = {
+    {"incremental", ParserType::INCREMENTAL},
+    {"ring_buffer", ParserType::RING_BUFFER},
+    {"ndjson", ParserType::NDJSON},
+    {"length_prefixed", ParserType::LENGTH_PREFIXED},
+    {"json_seq", ParserType::JSON_SEQ},
+};
+
+// 分块方式：size 为 0 表示对抗性切分
+struct ChunkPlan {
+    std::string name;
+    size_t size;
+};
+
+struct Result {
+    std::string corpus;
+    std::string parser;
+    std::string chunk;
+    uint64_t bytes = 0;
+    uint64_t messages = 0;
+    uint64_t calls = 0;
+    double seconds = 0;
+    bool ok = true;
+};
+
+// 编解码微基准的一项：同一输入、同一 items 数上的一种实现
+struct CodecResult {
+    std::string bench;
+    std::string impl;
+    uint64_t items = 0;
+    double seconds = 0;
+    bool ok = true;
+};
+
+// 防止被测循环被优化掉
+volatile double g_sink = 0;
+
+// 重复运行 fn 直到累计时间达到 min_time；fn 处理 items 项并返回校验是否通过
+template<typename Fn>
+CodecResult timeCodec(const char* bench, const char* impl, uint64_t items, double min_time, Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+    CodecResult result;
+    result.bench = bench;
+    result.impl = impl;
+    do {
+        Clock::time_point t0 = Clock::now();
+        bool ok = fn();
+        result.seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        result.items += items;
+        result.ok = result.ok && ok;
+    } while (result.ok && result.seconds < min_time);
+    return result;
+}
+
+// 数字解析：JsonNumberParser 与 strtod 解析同一批 %.17g 文本，两者结果须一致
+void benchNumbers(size_t count, double min_time, std::vector<CodecResult>& results) {
+    std::mt19937_64 rng(1);
+    std::vector<std::string> inputs;
+    char buf[64];
+    for (size_t i = 0; i < count; ++i) {
+        std::snprintf(buf, sizeof(buf), "%.17g", static_cast<double>(rng() % 100000000) / 997.0);
+        inputs.push_back(buf);
+    }
+
+    double fast_sum = 0;
+    double slow_sum = 0;
+    results.push_back(timeCodec("parse_double", "JsonNumberParser", count, min_time, [&]() {
+        double sum = 0;
+        for (const auto& s : inputs) {
+            JsonNumber n;
+            if (!JsonNumberParser::parse(s.data(), s.size(), n)) return false;
+            sum += n.toDouble();
+        }
+        fast_sum = sum;
+        g_sink = g_sink + sum;
+        return true;
+    }));
+    results.push_back(timeCodec("parse_double", "strtod", count, min_time, [&]() {
+        double sum = 0;
+        for (const auto& s : inputs) {
+            sum += std::strtod(s.c_str(), nullptr);
+        }
+        slow_sum = sum;
+        g_sink = g_sink + sum;
+        return true;
+    }));
+    if (fast_sum != slow_sum) {
+        results[results.size() - 2].ok = false;
+    }
+}
+
+// 写入：JsonWriter 与 ostringstream 生成同一批小消息，两者输出须逐字节一致
+// （浮点值取非整数，JsonWriter 对整数值的浮点会保留 ".0"）
+void benchWriter(size_t count, double min_time, std::vector<CodecResult>& results) {
+    std::string fast_out;
+    std::string slow_out;
+    results.push_back(timeCodec("write_message", "JsonWriter", count, min_time, [&]() {
+        JsonWriter writer;
+        fast_out.clear();
+        for (size_t i = 0; i < count; ++i) {
+            writer.clear();
+            writer.startObject();
+            writer.key("id");
+            writer.uint64Value(i);
+            writer.key("name");
+            writer.string("sensor-temperature");
+            writer.key("value");
+            writer.doubleValue(i * 0.25 + 20.125);
+            writer.key("ok");
+            writer.boolean(true);
+            writer.endObject();
+            fast_out.append(writer.data(), writer.size());
+        }
+        return true;
+    }));
+    results.push_back(timeCodec("write_message", "ostringstream", count, min_time, [&]() {
+        slow_out.clear();
+        for (size_t i = 0; i < count; ++i) {
+            std::ostringstream os;
+            os.precision(17);
+            os << "{\"id\":" << i << ",\"name\":\"" << "sensor-temperature" << "\",\"value\":"
+               << (i * 0.25 + 20.125) << ",\"ok\":" << "true" << "}";
+            slow_out += os.str();
+        }
+        return true;
+    }));
+    if (fast_out != slow_out) {
+        results[results.size() - 2].ok = false;
+    }
+}
+
+std::string randomWord(std::mt19937& rng, size_t min_len, size_t max_len) {
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyz";
+    size_t len = min_len + rng() % (max_len - min_len + 1);
+    std::string s;
+    for (size_t i = 0; i < len; ++i) {
+        s += letters[rng() % 26];
+    }
+    return s;
+}
+
+// 小消息：字段少、每条几十字节
+Corpus smallMessages(size_t target) {
+    Corpus corpus;
+    corpus.name = "small";
+    JsonWriter writer;
+    size_t total = 0;
+    for (int64_t i = 0; total < target; ++i) {
+        writer.clear();
+        writer.startObject();
+        writer.key("id");
+        writer.int64Value(i);
+        writer.key("ok");
+        writer.boolean(i % 3 != 0);
+        writer.key("v");
+        writer.int64Value(i % 100);
+        writer.endObject();
+        corpus.messages.push_back(writer.toString());
+        total += writer.size() + 1;
+    }
+    return corpus;
+}
+
+void nestedValue(JsonWriter& writer, std::mt19937& rng, int depth) {
+    if (depth >= 10 || rng() % 4 == 0) {
+        switch (rng() % 3) {
+            case 0: writer.int64Value(static_cast<int64_t>(rng() % 100000)); break;
+            case 1: writer.string(randomWord(rng, 3, 12)); break;
+            default: writer.boolean(rng() % 2 == 0); break;
+        }
+        return;
+    }
+    size_t n = 2 + rng() % 4;
+    if (rng() % 2) {
+        writer.startArray();
+        for (size_t i = 0; i < n; ++i) {
+            nestedValue(writer, rng, depth + 1);
+        }
+        writer.endArray();
+    } else {
+        writer.startObject();
+        for (size_t i = 0; i < n; ++i) {
+            writer.key(randomWord(rng, 2, 8));
+            nestedValue(writer, rng, depth + 1);
+        }
+        writer.endObject();
+    }
+}
+
+// 大的深层嵌套文档：每条约 32KB 以上
+Corpus nestedDocuments(size_t target, std::mt19937& rng) {
+    Corpus corpus;
+    corpus.name = "nested";
+    JsonWriter writer;
+    size_t total = 0;
+    while (total < target) {
+        writer.clear();
+        writer.startObject();
+        writer.key("items");
+        writer.startArray();
+        while (writer.size() < 32 * 1024) {
+            nestedValue(writer, rng, 1);
+        }
+        writer.endArray();
+        writer.endObject();
+        corpus.messages.push_back(writer.toString());
+        total += writer.size() + 1;
+    }
+    return corpus;
+}
+
+// 以字符串为主的日志：长文本、引号、反斜杠、转义字符和括号
+Corpus logLines(size_t target, std::mt19937& rng) {
+    static const char* levels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+    Corpus corpus;
+    corpus.name = "logs";
+    JsonWriter writer;
+    size_t total = 0;
+    for (int64_t i = 0; total < target; ++i) {
+        std::string text;
+        while (text.size() < 200 + rng() % 300) {
+            text += randomWord(rng, 1, 10);
+            switch (rng() % 8) {
+                case 0: text += " \"quoted {value}\" "; break;
+                case 1: text += " C:\\path\\to\\file "; break;
+                case 2: text += "\t[tab]\n"; break;
+                default: text += ' '; break;
+            }
+        }
+        writer.clear();
+        writer.startObject();
+        writer.key("ts");
+        writer.int64Value(1700000000000LL + i * 17);
+        writer.key("level");
+        writer.string(levels[rng() % 4]);
+        writer.key("logger");
+        writer.string("service." + randomWord(rng, 4, 10));
+        writer.key("msg");
+        writer.string(text);
+        writer.endObject();
+        corpus.messages.push_back(writer.toString());
+        total += writer.size() + 1;
+    }
+    return corpus;
+}
+
+// 数值遥测：短键名、大量浮点数组
+Corpus telemetry(size_t target, std::mt19937& rng) {
+    Corpus corpus;
+    corpus.name = "telemetry";
+    std::uniform_real_distribution<double> value(-1000.0, 1000.0);
+    JsonWriter writer;
+    size_t total = 0;
+    for (int64_t i = 0; total < target; ++i) {
+        writer.clear();
+        writer.startObject();
+        writer.key("dev");
+        writer.int64Value(static_cast<int64_t>(rng() % 512));
+        writer.key("ts");
+        writer.int64Value(1700000000000LL + i);
+        writer.key("v");
+        writer.startArray();
+        for (int k = 0; k < 32; ++k) {
+            writer.doubleValue(value(rng));
+        }
+        writer.endArray();
+        writer.endObject();
+        corpus.messages.push_back(writer.toString());
+        total += writer.size() + 1;
+    }
+    return corpus;
+}
+
+// 按解析器的分帧格式编码语料
+std::string encode(ParserType type, const std::vector<std::string>& messages) {
+    std::string out;
+    for (const auto& msg : messages) {
+        if (type == ParserType::LENGTH_PREFIXED) {
+            LengthPrefixedJsonParser::appendHeader(out, static_cast<uint32_t>(msg.size()));
+            out += msg;
+        } else if (type == ParserType::JSON_SEQ) {
+            out += static_cast<char>(JsonSeqParser::RS);
+            out += msg;
+            out += '\n';
+        } else {
+            out += msg;
+            out += '\n';
+        }
+    }
+    return out;
+}
+
+// 分块边界：固定大小，或对抗性切分——每块 1~64 字节，尽量切在引号、反斜杠、括号之后，
+// 使下一块从字符串内部、转义序列中间或消息起点开始
+std::vector<size_t> chunkBounds(const std::string& data, size_t size, std::mt19937& rng) {
+    std::vector<size_t> bounds;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t next;
+        if (size) {
+            next = pos + size;
+        } else {
+            size_t limit = std::min(data.size(), pos + 1 + rng() % 64);
+            next = limit;
+            for (size_t i = pos; i < limit; ++i) {
+                const char c = data[i];
+                if (c == '"' || c == '\\' || c == '{' || c == '}' || c == '[' || c == ']' || c == '\n') {
+                    next = i + 1;
+                    break;
+                }
+            }
+        }
+        pos = std::min(next, data.size());
+        bounds.push_back(pos);
+    }
+    return bounds;
+}
+
+Result run(const Corpus& corpus, const ParserEntry& parser_entry, const ChunkPlan& plan, double min_time) {
+    Result result;
+    result.corpus = corpus.name;
+    result.parser = parser_entry.name;
+    result.chunk = plan.name;
+
+    const std::string data = encode(parser_entry.type, corpus.messages);
+    std::mt19937 rng(42);
+    const std::vector<size_t> bounds = chunkBounds(data, plan.size, rng);
+
+    using Clock = std::chrono::steady_clock;
+    uint64_t checksum = 0;
+    do {
+        uint64_t delivered = 0;
+        Clock::time_point t0 = Clock::now();
+        auto parser = JsonParserFactory::createViewParser(parser_entry.type, [&](const JsonFrame& frame) {
+            ++delivered;
+            checksum += frame.size();
+        }, [&](const std::string&) {
+            result.ok = false;
+        });
+        size_t pos = 0;
+        for (size_t end : bounds) {
+            parser->addData(data.data() + pos, end - pos);
+            pos = end;
+        }
+        parser->finish();
+        result.seconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        result.bytes += data.size();
+        result.messages += delivered;
+        result.calls += bounds.size();
+        if (delivered != corpus.messages.size()) {
+            result.ok = false;
+        }
+    } while (result.ok && result.seconds < min_time);
+
+    if (checksum == 0) {
+        result.ok = false;
+    }
+    return result;
+}
+
+void writeJson(const std::vector<Result>& results, const std::vector<CodecResult>& codec, bool quick, std::ostream& os) {
+    JsonWriter writer(2);
+    writer.startObject();
+    writer.key("scanner");
+    writer.string(JsonStructuralScanner::implementation());
+    writer.key("quick");
+    writer.boolean(quick);
+    writer.key("results");
+    writer.startArray();
+    for (const auto& r : results) {
+        writer.startObject();
+        writer.key("corpus");
+        writer.string(r.corpus);
+        writer.key("parser");
+        writer.string(r.parser);
+        writer.key("chunk");
+        writer.string(r.chunk);
+        writer.key("bytes");
+        writer.uint64Value(r.bytes);
+        writer.key("messages");
+        writer.uint64Value(r.messages);
+        writer.key("calls");
+        writer.uint64Value(r.calls);
+        writer.key("seconds");
+        writer.doubleValue(r.seconds);
+        writer.key("mb_per_s");
+        writer.doubleValue(r.seconds > 0 ? r.bytes / r.seconds / 1e6 : 0.0);
+        writer.key("msgs_per_s");
+        writer.doubleValue(r.seconds > 0 ? r.messages / r.seconds : 0.0);
+        writer.key("ok");
+        writer.boolean(r.ok);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("codec");
+    writer.startArray();
+    for (const auto& r : codec) {
+        writer.startObject();
+        writer.key("bench");
+        writer.string(r.bench);
+        writer.key("impl");
+        writer.string(r.impl);
+        writer.key("items");
+        writer.uint64Value(r.items);
+        writer.key("seconds");
+        writer.doubleValue(r.seconds);
+        writer.key("items_per_s");
+        writer.doubleValue(r.seconds > 0 ? r.items / r.seconds : 0.0);
+        writer.key("ok");
+        writer.boolean(r.ok);
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+    os.write(writer.data(), static_cast<std::streamsize>(writer.size()));
+    os << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    double min_time = 0.3;
+    std::string out_path;
+    std::string suite_filter;
+    std::string corpus_filter;
+    std::string parser_filter;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            quick = true;
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (arg == "--suite" && i + 1 < argc) {
+            suite_filter = argv[++i];
+        } else if (arg == "--corpus" && i + 1 < argc) {
+            corpus_filter = argv[++i];
+        } else if (arg == "--parser" && i + 1 < argc) {
+            parser_filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            min_time = std::atof(argv[++i]);
+        } else {
+            std::cerr << "用法: " << argv[0]
+                      << " [--quick] [--out result.json] [--suite 名称] [--corpus 名称] [--parser 名称] [--min-time 秒]"
+                      << std::endl;
+            return 2;
+        }
+    }
+    if (quick) {
+        min_time = 0;
+    }
+
+    const bool run_framing = suite_filter.empty() || suite_filter == "framing";
+    const bool run_codec = suite_filter.empty() || suite_filter == "codec";
+    const size_t target = quick ? 256 * 1024 : 16 * 1024 * 1024;
+    std::mt19937 rng(7);
+    std::vector<Corpus> corpora;
+    if (run_framing) {
+        corpora.push_back(smallMessages(target));
+        corpora.push_back(nestedDocuments(target, rng));
+        corpora.push_back(logLines(target, rng));
+        corpora.push_back(telemetry(target, rng));
+    }
+
+    std::vector<ChunkPlan> plans = {
+        {"16", 16}, {"256", 256}, {"4K", 4096}, {"64K", 64 * 1024}, {"1M", 1024 * 1024}, {"adversarial", 0}
+    };
+
+    std::vector<Result> results;
+    bool all_ok = true;
+    if (run_framing) {
+        std::printf("%-10s %-16s %-12s %12s %14s\n", "corpus", "parser", "chunk", "MB/s", "msg/s");
+    }
+    for (const auto& corpus : corpora) {
+        if (!corpus_filter.empty() && corpus.name != corpus_filter) continue;
+        for (const auto& parser : kParsers) {
+            if (!parser_filter.empty() && parser_filter != parser.name) continue;
+            for (const auto& plan : plans) {
+                Result r = run(corpus, parser, plan, min_time);
+                all_ok = all_ok && r.ok;
+                std::printf("%-10s %-16s %-12s %12.1f %14.0f%s\n", r.corpus.c_str(), r.parser.c_str(), r.chunk.c_str(),
+                            r.bytes / r.seconds / 1e6, r.messages / r.seconds, r.ok ? "" : "  FAILED");
+                results.push_back(r);
+            }
+        }
+    }
+
+    std::vector<CodecResult> codec;
+    if (run_codec) {
+        const size_t items = quick ? 2000 : 200000;
+        benchNumbers(items, min_time, codec);
+        benchWriter(items, min_time, codec);
+        std::printf("%s%-16s %-18s %14s\n", run_framing ? "\n" : "", "bench", "impl", "Mitems/s");
+        for (const auto& r : codec) {
+            all_ok = all_ok && r.ok;
+            std::printf("%-16s %-18s %14.2f%s\n", r.bench.c_str(), r.impl.c_str(),
+                        r.seconds > 0 ? r.items / r.seconds / 1e6 : 0.0, r.ok ? "" : "  FAILED");
+        }
+    }
+
+    if (!out_path.empty()) {
+        std::ofstream out(out_path.c_str());
+        if (!out) {
+            std::cerr << "无法写入: " << out_path << std::endl;
+            return 1;
+        }
+        writeJson(results, codec, quick, out);
+    }
+    return all_ok ? 0 : 1;
+}
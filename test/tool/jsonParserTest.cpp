@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 #include "jsonParser.h"
+#include <chrono>
 #include <vector>
 #include <string>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <unistd.h>
 
 class JsonStateTrackerTest : public ::testing::Test {
 protected:
@@ -80,6 +86,42 @@ TEST_F(JsonStateTrackerTest, JsonWithArray) {
     EXPECT_TRUE(tracker.isComplete());
 }
 
+TEST_F(JsonStateTrackerTest, BracesInsideString) {
+    std::string json = "{\"text\":\"a } b ] c { [\",\"n\":1}";
+    bool found = false;
+
+    for (size_t i = 0; i < json.size(); ++i) {
+        found = tracker.processChar(json[i]);
+        if (i < json.size() - 1) {
+            EXPECT_FALSE(found);
+        }
+    }
+
+    EXPECT_TRUE(found);
+    EXPECT_TRUE(tracker.isComplete());
+}
+
+TEST_F(JsonStateTrackerTest, EscapedBackslashBeforeQuote) {
+    // 字符串以转义的反斜杠结尾，紧随的引号是真正的字符串结束
+    std::string json = "{\"path\":\"C:\\\\\",\"x\":\"}\"}";
+    size_t consumed = tracker.scan(json.data(), json.size());
+    EXPECT_EQ(json.size(), consumed);
+    EXPECT_TRUE(tracker.isComplete());
+}
+
+TEST_F(JsonStateTrackerTest, ScanCarriesStringStateAcrossCalls) {
+    std::string json = "{\"s\":\"}}}\\\"]]]\"}";
+    for (size_t split = 1; split < json.size(); ++split) {
+        tracker.reset();
+        size_t first = tracker.scan(json.data(), split);
+        EXPECT_EQ(split, first);
+        EXPECT_FALSE(tracker.isComplete());
+        size_t second = tracker.scan(json.data() + split, json.size() - split);
+        EXPECT_EQ(json.size() - split, second) << "split at " << split;
+        EXPECT_TRUE(tracker.isComplete());
+    }
+}
+
 class IncrementalJsonParserTest : public ::testing::Test {
 protected:
     std::vector<std::string> received_jsons;
@@ -142,6 +184,73 @@ TEST_F(IncrementalJsonParserTest, JsonWithWhitespace) {
     EXPECT_EQ("{\"id\":2}", received_jsons[1]);
 }
 
+TEST_F(IncrementalJsonParserTest, BracesInsideString) {
+    std::string json1 = "{\"msg\":\"closing}early\"}";
+    std::string json2 = "[\"]\",\"\\\"[\"]";
+
+    parser->addData(json1 + json2);
+
+    ASSERT_EQ(2, received_jsons.size());
+    EXPECT_EQ(json1, received_jsons[0]);
+    EXPECT_EQ(json2, received_jsons[1]);
+}
+
+TEST_F(IncrementalJsonParserTest, WhitespaceInsideStringPreserved) {
+    std::string json = "{\"text\": \"hello world\", \"n\": [1, 2]}";
+    parser->addData("\n  " + json + "  \n");
+
+    ASSERT_EQ(1, received_jsons.size());
+    EXPECT_EQ(json, received_jsons[0]);
+}
+
+TEST_F(IncrementalJsonParserTest, MinifyKeepsStrings) {
+    parser->setMinify(true);
+    parser->addData("{ \"text\" : \"hello  world\\\" { \" ,\n  \"n\" : [ 1 , 2 ] }");
+
+    ASSERT_EQ(1, received_jsons.size());
+    EXPECT_EQ("{\"text\":\"hello  world\\\" { \",\"n\":[1,2]}", received_jsons[0]);
+}
+
+TEST_F(IncrementalJsonParserTest, ManySmallMessagesAcrossCompaction) {
+    // 足够多的消息以触发多次缓冲区前移，并让部分消息跨越 addData 边界
+    std::string stream;
+    const int count = 5000;
+    for (int i = 0; i < count; ++i) {
+        stream += "{\"id\":" + std::to_string(i) + "}\n";
+    }
+    for (size_t pos = 0; pos < stream.size(); pos += 777) {
+        parser->addData(stream.substr(pos, 777));
+    }
+
+    ASSERT_EQ(static_cast<size_t>(count), received_jsons.size());
+    for (int i = 0; i < count; ++i) {
+        EXPECT_EQ("{\"id\":" + std::to_string(i) + "}", received_jsons[i]);
+    }
+}
+
+TEST(IncrementalJsonParserViewTest, DeliversViewsIntoBuffer) {
+    std::vector<std::string> contents;
+    std::vector<bool> contiguous;
+    auto parser = JsonParserFactory::createViewParser(
+        JsonParserFactory::ParserType::INCREMENTAL,
+        [&](const JsonFrame& frame) {
+            contents.push_back(frame.toString());
+            contiguous.push_back(frame.contiguous());
+        }
+    );
+
+    parser->addData("  {\"msg\":\"a b\"}\n[1, 2]");
+    parser->addData("  {\"x\":");
+    parser->addData("\"}\"}");
+
+    ASSERT_EQ(3u, contents.size());
+    // 视图不做空白处理，只去掉JSON之前的字节
+    EXPECT_EQ("{\"msg\":\"a b\"}", contents[0]);
+    EXPECT_EQ("[1, 2]", contents[1]);
+    EXPECT_EQ("{\"x\":\"}\"}", contents[2]);
+    EXPECT_TRUE(contiguous[0] && contiguous[1] && contiguous[2]);
+}
+
 class RingBufferJsonParserTest : public ::testing::Test {
 protected:
     std::vector<std::string> received_jsons;
@@ -216,6 +325,729 @@ TEST_F(RingBufferJsonParserTest, ClearParser) {
     EXPECT_EQ(json2, received_jsons[0]);
 }
 
+TEST_F(RingBufferJsonParserTest, BracesInsideString) {
+    std::string json1 = "{\"msg\":\"closing } early, with spaces\"}";
+    std::string json2 = "[\"]\",\"\\\"[\"]";
+
+    parser->addData(json1 + json2);
+
+    ASSERT_EQ(2, received_jsons.size());
+    EXPECT_EQ(json1, received_jsons[0]);
+    EXPECT_EQ(json2, received_jsons[1]);
+}
+
+TEST_F(RingBufferJsonParserTest, FrameAcrossSegmentsHasTwoSpans) {
+    std::vector<JsonFrame> frames;
+    std::vector<std::string> contents;
+    auto view_parser = JsonParserFactory::createViewParser(
+        JsonParserFactory::ParserType::RING_BUFFER,
+        [&](const JsonFrame& frame) {
+            frames.push_back(frame);
+            contents.push_back(frame.toString());
+        },
+        nullptr,
+        32
+    );
+
+    // 第一条占用分段前部，第二条跨越分段边界
+    const size_t segment = RingBufferJsonParser::BufferChunk::SIZE;
+    std::string json1 = "{\"pad\":\"" + std::string(segment - 20, 'x') + "\"}";
+    std::string json2 = "{\"id\":2,\"s\":\"ab\"}";
+    view_parser->addData(json1);
+    view_parser->addData(json2);
+
+    ASSERT_EQ(2u, contents.size());
+    EXPECT_EQ(json1, contents[0]);
+    EXPECT_EQ(json2, contents[1]);
+    EXPECT_TRUE(frames[0].contiguous());
+    EXPECT_FALSE(frames[1].contiguous());
+    EXPECT_EQ(json2.size(), frames[1].size());
+}
+
+TEST_F(RingBufferJsonParserTest, RandomChunksWithSeparators) {
+    std::string stream;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 300; ++i) {
+        std::string json = (i % 3 == 0)
+            ? "[" + std::to_string(i) + ",\"a ] b\"]"
+            : "{\"id\":" + std::to_string(i) + ",\"s\":\"} \\\" {\",\"pad\":\"" + std::string(i % 50, 'x') + "\"}";
+        expected.push_back(json);
+        stream += json;
+        stream += std::string(i % 4, ' ') + (i % 5 == 0 ? "\n" : "");
+    }
+
+    unsigned seed = 7;
+    size_t pos = 0;
+    while (pos < stream.size()) {
+        seed = seed * 1103515245 + 12345;
+        size_t n = 1 + (seed >> 16) % 97;
+        parser->addData(stream.substr(pos, n));
+        pos += n;
+    }
+
+    EXPECT_EQ(expected, received_jsons);
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST(RingBufferJsonParserSegmentTest, GrowsBySegmentsAndRecycles) {
+    const size_t segment = RingBufferJsonParser::BufferChunk::SIZE;
+    std::vector<std::string> received;
+    std::vector<bool> contiguous;
+    RingBufferJsonParser parser(nullptr);
+    parser.setViewCallback([&](const JsonFrame& frame) {
+        received.push_back(frame.toString());
+        contiguous.push_back(frame.contiguous());
+    });
+    EXPECT_EQ(0u, parser.capacity());
+
+    // 跨越多个分段的消息：逐段增长，交付时拼接为连续视图
+    std::string big = "{\"data\":\"" + std::string(segment * 3 + 100, 'y') + "\"}";
+    parser.addData(big.substr(0, segment * 2));
+    EXPECT_EQ(2u, parser.segmentCount());
+    parser.addData(big.substr(segment * 2));
+    ASSERT_EQ(1u, received.size());
+    EXPECT_EQ(big, received[0]);
+    EXPECT_TRUE(contiguous[0]);
+
+    // 交付后只保留写入位置所在的分段
+    EXPECT_EQ(1u, parser.segmentCount());
+    EXPECT_EQ(segment, parser.capacity());
+
+    for (int i = 0; i < 1000; ++i) {
+        parser.addData("{\"i\":" + std::to_string(i) + "}\n");
+    }
+    EXPECT_EQ(1001u, received.size());
+    EXPECT_EQ("{\"i\":999}", received.back());
+    EXPECT_LE(parser.segmentCount(), 1u);
+}
+
+TEST(RingBufferJsonParserSegmentTest, MaxMessageSizeDropsAndRecovers) {
+    std::vector<std::string> received;
+    std::vector<std::string> errors;
+    RingBufferJsonParser parser([&](const std::string& json) {
+        received.push_back(json);
+    }, [&](const std::string& error) {
+        errors.push_back(error);
+    }, 8192, 1000);
+    EXPECT_EQ(1000u, parser.maxMessageSize());
+
+    std::string big = "{\"data\":\"" + std::string(5000, '}') + "\"}";
+    std::string stream = "{\"a\":1}\n" + big + "\n{\"b\":2}\n";
+    // 逐块写入与 prepare/commit 两种输入路径
+    for (int round = 0; round < 2; ++round) {
+        received.clear();
+        errors.clear();
+        for (size_t pos = 0; pos < stream.size(); pos += 300) {
+            size_t n = std::min<size_t>(300, stream.size() - pos);
+            if (round == 0) {
+                parser.addData(stream.data() + pos, n);
+            } else {
+                std::memcpy(parser.prepare(n), stream.data() + pos, n);
+                parser.commit(n);
+            }
+        }
+        ASSERT_EQ(2u, received.size()) << round;
+        EXPECT_EQ("{\"a\":1}", received[0]);
+        EXPECT_EQ("{\"b\":2}", received[1]);
+        EXPECT_EQ(1u, errors.size());
+        EXPECT_LE(parser.segmentCount(), 1u);
+    }
+}
+
+// 文件映射分帧：两种解析器都应逐条交付，并正确衔接调用前后的未完成消息
+// 测试语料：第 i 条消息的字符串含 i % k 个填充字符，以及括号、转义引号与控制字符
+static std::vector<std::string> makeMessages(size_t n, size_t k) {
+    std::vector<std::string> messages;
+    for (size_t i = 0; i < n; ++i) {
+        messages.push_back("{\"id\":" + std::to_string(i) + ",\"s\":\"" + std::string(i % k, 'x') + "}{]\\\"\x1f\"}");
+    }
+    return messages;
+}
+
+class JsonParseFileTest : public ::testing::TestWithParam<JsonParserFactory::ParserType> {
+protected:
+    void SetUp() override {
+        path = ::testing::TempDir() + "json_parse_file_test.jsonl";
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    void writeFile(const std::string& content) {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << content;
+    }
+
+    std::string path;
+};
+
+TEST_P(JsonParseFileTest, FramesWholeFile) {
+    std::string content;
+    std::vector<std::string> expected = makeMessages(1000, 1);
+    for (const auto& msg : expected) {
+        content += msg + "\n";
+    }
+    // 文件末尾不完整的消息留在缓冲区中
+    content += "{\"tail\":";
+    writeFile(content);
+
+    std::vector<std::string> received;
+    auto parser = JsonParserFactory::createViewParser(GetParam(), [&](const JsonFrame& frame) {
+        received.push_back(frame.toString());
+    });
+    ASSERT_TRUE(parser->parseFile(path));
+    EXPECT_EQ(expected, received);
+
+    parser->addData("1}");
+    ASSERT_EQ(expected.size() + 1, received.size());
+    EXPECT_EQ("{\"tail\":1}", received.back());
+}
+
+TEST_P(JsonParseFileTest, CompletesPendingMessage) {
+    writeFile("\"b\":[1,2]}\n{\"c\":3}\n");
+    std::vector<std::string> received;
+    auto parser = JsonParserFactory::createParser(GetParam(), [&](const std::string& json) {
+        received.push_back(json);
+    });
+    parser->addData("{\"a\":\"}\",");
+    ASSERT_TRUE(parser->parseFile(path));
+    std::vector<std::string> expected = {"{\"a\":\"}\",\"b\":[1,2]}", "{\"c\":3}"};
+    EXPECT_EQ(expected, received);
+}
+
+TEST_P(JsonParseFileTest, MissingFileReportsError) {
+    std::vector<std::string> errors;
+    auto parser = JsonParserFactory::createParser(GetParam(), [](const std::string&) {},
+        [&](const std::string& e) { errors.push_back(e); });
+    EXPECT_FALSE(parser->parseFile(path + ".missing"));
+    EXPECT_EQ(1u, errors.size());
+}
+
+TEST_P(JsonParseFileTest, EmptyFile) {
+    writeFile("");
+    size_t count = 0;
+    auto parser = JsonParserFactory::createParser(GetParam(), [&](const std::string&) { ++count; });
+    EXPECT_TRUE(parser->parseFile(path));
+    EXPECT_EQ(0u, count);
+}
+
+INSTANTIATE_TEST_SUITE_P(BothParsers, JsonParseFileTest,
+    ::testing::Values(JsonParserFactory::ParserType::INCREMENTAL, JsonParserFactory::ParserType::RING_BUFFER));
+
+// 按解析器类型参数化的测试基类：创建解析器，收集交付的消息与错误
+class JsonParserParamTest : public ::testing::TestWithParam<JsonParserFactory::ParserType> {
+protected:
+    void SetUp() override {
+        parser = JsonParserFactory::createParser(GetParam(), collectMessages(), collectErrors());
+    }
+
+    JsonParserBase::JsonCallback collectMessages() {
+        return [this](const std::string& json) { received.push_back(json); };
+    }
+
+    JsonParserBase::ErrorCallback collectErrors() {
+        return [this](const std::string& error) { errors.push_back(error); };
+    }
+
+    // 随机切成 1~max_chunk 字节的块，交替使用 addData 与 prepare/commit（预留空间可大于写入量）
+    void feed(const std::string& stream, unsigned seed, size_t max_chunk) {
+        std::mt19937 rng(seed);
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            size_t n = std::min(stream.size() - pos, size_t(1 + rng() % max_chunk));
+            if (rng() % 2) {
+                parser->addData(stream.data() + pos, n);
+            } else {
+                std::memcpy(parser->prepare(n + rng() % 16), stream.data() + pos, n);
+                parser->commit(n);
+            }
+            pos += n;
+        }
+    }
+
+    std::vector<std::string> received;
+    std::vector<std::string> errors;
+    std::unique_ptr<JsonParserBase> parser;
+};
+
+// 指针重载、prepare/commit 与 readFrom 输入
+class JsonZeroCopyInputTest : public JsonParserParamTest {
+protected:
+    void SetUp() override {
+        expected = makeMessages(300, 50);
+        for (size_t i = 0; i < expected.size(); ++i) {
+            stream += expected[i] + (i % 3 ? "\n" : " \r\n  ");
+        }
+        // 小缓冲区使环形缓冲区频繁回绕和扩容
+        parser = JsonParserFactory::createParser(GetParam(), collectMessages(), collectErrors(), 64);
+    }
+
+    std::string stream;
+    std::vector<std::string> expected;
+};
+
+TEST_P(JsonZeroCopyInputTest, PointerOverload) {
+    std::mt19937 rng(1);
+    size_t pos = 0;
+    while (pos < stream.size()) {
+        size_t n = std::min(stream.size() - pos, size_t(rng() % 100));
+        parser->addData(stream.data() + pos, n);
+        pos += n;
+    }
+    EXPECT_EQ(expected, received);
+}
+
+TEST_P(JsonZeroCopyInputTest, PrepareCommitRandomChunks) {
+    std::mt19937 rng(2);
+    size_t pos = 0;
+    while (pos < stream.size()) {
+        // 预留的空间可以大于实际写入的字节数
+        size_t n = std::min(stream.size() - pos, size_t(rng() % 120));
+        size_t reserve = n + rng() % 64;
+        char* p = parser->prepare(reserve);
+        ASSERT_NE(nullptr, p);
+        std::memcpy(p, stream.data() + pos, n);
+        parser->commit(n);
+        pos += n;
+    }
+    EXPECT_EQ(expected, received);
+
+    // 与 addData 混用
+    parser->addData("{\"a\":");
+    std::memcpy(parser->prepare(2), "1}", 2);
+    parser->commit(2);
+    ASSERT_EQ(expected.size() + 1, received.size());
+    EXPECT_EQ("{\"a\":1}", received.back());
+}
+
+TEST_P(JsonZeroCopyInputTest, ReadFromPipe) {
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    std::thread writer([&]() {
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            ssize_t n = ::write(fds[1], stream.data() + pos, std::min<size_t>(777, stream.size() - pos));
+            if (n <= 0) break;
+            pos += static_cast<size_t>(n);
+        }
+        ::close(fds[1]);
+    });
+    ssize_t n;
+    while ((n = parser->readFrom(fds[0], 500)) > 0) {}
+    writer.join();
+    ::close(fds[0]);
+    EXPECT_EQ(0, n);
+    EXPECT_EQ(expected, received);
+
+    // 无效 fd 返回 -1
+    EXPECT_EQ(-1, parser->readFrom(-1));
+}
+
+INSTANTIATE_TEST_SUITE_P(BothParsers, JsonZeroCopyInputTest,
+    ::testing::Values(JsonParserFactory::ParserType::INCREMENTAL, JsonParserFactory::ParserType::RING_BUFFER));
+
+// 消息长度与嵌套深度上限：超限时报错、丢弃并在下一个换行后的 '{' 或 '[' 处重新同步
+class JsonLimitsTest : public JsonParserParamTest {};
+
+TEST_P(JsonLimitsTest, UnmatchedBraceResyncsOnNextRecord) {
+    parser->setMaxMessageSize(1000);
+    EXPECT_EQ(1000u, parser->maxMessageSize());
+    std::string stream = "{\"a\":1}\n{\"broken\":[";
+    for (int i = 0; i < 2000; ++i) {
+        // 坏区域内同一行的 '{' 不是同步点
+        stream += "{\"x\":" + std::to_string(i) + ",";
+    }
+    stream += "\n  \n {\"ok\":1}\n[2]\n";
+    feed(stream, 3, 700);
+
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":1}", "{\"ok\":1}", "[2]"}), received);
+    ASSERT_EQ(1u, errors.size());
+}
+
+TEST_P(JsonLimitsTest, OversizedMessageInSingleChunk) {
+    // 坏消息与后面的消息在同一次 addData 中：应在越过上限处开始重新同步，而不是吞掉整块数据
+    parser->setMaxMessageSize(1000);
+    std::string stream = "{\"broken\":[";
+    for (int i = 0; i < 2000; ++i) {
+        stream += "{\"x\":1,";
+    }
+    std::vector<std::string> expected;
+    for (int i = 0; i < 100; ++i) {
+        expected.push_back("{\"ok\":" + std::to_string(i) + "}");
+        stream += "\n" + expected.back();
+    }
+    parser->addData(stream);
+    EXPECT_EQ(expected, received);
+    EXPECT_EQ(1u, errors.size());
+
+    parser->addData("{\"after\":1}\n");
+    EXPECT_EQ("{\"after\":1}", received.back());
+
+    // 越过上限的恰好是换行：紧随其后的 '{' 即为同步点
+    received.clear();
+    parser->addData("[" + std::string(999, ' ') + "\n{\"next\":1}\n");
+    EXPECT_EQ((std::vector<std::string>{"{\"next\":1}"}), received);
+    EXPECT_EQ(2u, errors.size());
+}
+
+TEST_P(JsonLimitsTest, DepthLimit) {
+    parser->setMaxDepth(3);
+    EXPECT_EQ(3u, parser->maxDepth());
+    feed("[[[1]]]\n{\"a\":[{\"b\":[1]}]} {\"same line\":1}\nx{\"no\":1}\n{\"x\":[1]}\n", 3, 700);
+    EXPECT_EQ((std::vector<std::string>{"[[[1]]]", "{\"x\":[1]}"}), received);
+    ASSERT_EQ(1u, errors.size());
+
+    // clear() 结束重新同步，深度上限保留
+    parser->addData("{\"a\":{\"b\":{\"c\":{}}}}\ngarbage {\"y\":1}");
+    parser->clear();
+    parser->addData("{\"z\":1}");
+    EXPECT_EQ("{\"z\":1}", received.back());
+    EXPECT_EQ(2u, errors.size());
+}
+
+TEST_P(JsonLimitsTest, LimitsDoNotAffectValidStreams) {
+    parser->setMaxMessageSize(200);
+    parser->setMaxDepth(8);
+    std::string stream;
+    std::vector<std::string> expected = makeMessages(500, 50);
+    for (auto& msg : expected) {
+        // 真实嵌套深度 5，字符串内的括号不计入深度
+        msg.insert(msg.size() - 1, ",\"n\":[[[[1]]]]");
+        stream += msg + "\n";
+    }
+    feed(stream, 3, 700);
+    EXPECT_EQ(expected, received);
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_P(JsonLimitsTest, ParseFileResyncs) {
+    std::string path = ::testing::TempDir() + "json_limits_test.jsonl";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << "{\"a\":1}\n{\"deep\":[[[[[[1]]]]]]}\n{\"b\":" << std::string(5000, '1') << "}\n{\"c\":3}\n{\"tail\":";
+    }
+    parser->setMaxMessageSize(1000);
+    parser->setMaxDepth(4);
+    ASSERT_TRUE(parser->parseFile(path));
+    std::remove(path.c_str());
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":1}", "{\"c\":3}"}), received);
+    EXPECT_EQ(2u, errors.size());
+    parser->addData("9}");
+    EXPECT_EQ("{\"tail\":9}", received.back());
+}
+
+INSTANTIATE_TEST_SUITE_P(BothParsers, JsonLimitsTest,
+    ::testing::Values(JsonParserFactory::ParserType::INCREMENTAL, JsonParserFactory::ParserType::RING_BUFFER));
+
+// 按解析器的分帧格式编码：长度前缀、RFC 7464 JSON 文本序列，其余解析器每行一条
+static std::string encodeMessages(JsonParserFactory::ParserType type, const std::vector<std::string>& messages) {
+    std::string out;
+    for (const auto& msg : messages) {
+        if (type == JsonParserFactory::ParserType::LENGTH_PREFIXED) {
+            LengthPrefixedJsonParser::appendHeader(out, static_cast<uint32_t>(msg.size()));
+            out += msg;
+        } else if (type == JsonParserFactory::ParserType::JSON_SEQ) {
+            out += '\x1e' + msg + "\n";
+        } else {
+            out += msg + "\n";
+        }
+    }
+    return out;
+}
+
+// 按分隔符分帧：换行、长度前缀与 RFC 7464 JSON 文本序列
+class JsonDelimitedParserTest : public JsonParserParamTest {
+protected:
+    void SetUp() override {
+        JsonParserParamTest::SetUp();
+        expected = makeMessages(300, 40);
+    }
+
+    std::vector<std::string> expected;
+};
+
+TEST_P(JsonDelimitedParserTest, RandomChunks) {
+    feed(encodeMessages(GetParam(), expected), 4, 300);
+    parser->finish();
+    EXPECT_EQ(expected, received);
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_P(JsonDelimitedParserTest, ParseFileCompletesPendingMessage) {
+    std::string stream = encodeMessages(GetParam(), expected);
+    std::string path = ::testing::TempDir() + "json_delimited_test.bin";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << stream.substr(10);
+    }
+    parser->addData(stream.data(), 10);
+    ASSERT_TRUE(parser->parseFile(path));
+    std::remove(path.c_str());
+    EXPECT_EQ(expected, received);
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_P(JsonDelimitedParserTest, MaxMessageSize) {
+    parser->setMaxMessageSize(1000);
+    std::vector<std::string> messages = {"{\"a\":1}", "{\"big\":\"" + std::string(5000, 'x') + "\"}", "[2]"};
+    feed(encodeMessages(GetParam(), messages), 4, 300);
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":1}", "[2]"}), received);
+    EXPECT_EQ(1u, errors.size());
+}
+
+TEST_P(JsonDelimitedParserTest, ValidateAndDepth) {
+    DelimitedJsonParser* delimited = dynamic_cast<DelimitedJsonParser*>(parser.get());
+    ASSERT_NE(nullptr, delimited);
+    delimited->setValidate(true);
+    parser->setMaxDepth(2);
+    std::vector<std::string> messages = {"{\"a\":1}", "{\"b\":", "[[[1]]]", "[[2]]"};
+    feed(encodeMessages(GetParam(), messages), 4, 300);
+    parser->finish();
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":1}", "[[2]]"}), received);
+    EXPECT_EQ(2u, errors.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(DelimitedParsers, JsonDelimitedParserTest,
+    ::testing::Values(JsonParserFactory::ParserType::NDJSON, JsonParserFactory::ParserType::LENGTH_PREFIXED,
+                      JsonParserFactory::ParserType::JSON_SEQ));
+
+TEST(NdjsonParserTest, LineEndingsAndLastLine) {
+    std::vector<std::string> received;
+    NdjsonParser parser([&](const std::string& json) {
+        received.push_back(json);
+    });
+    // 不校验时按行原样交付（去除首尾空白）
+    parser.addData("{\"a\":1}\r\n\n   \r\n  [1, 2] \n{\"c\":\"no newline\"}");
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":1}", "[1, 2]"}), received);
+    parser.finish();
+    EXPECT_EQ("{\"c\":\"no newline\"}", received.back());
+}
+
+TEST(JsonSeqParserTest, TruncatedRecordDropped) {
+    std::vector<std::string> received;
+    std::vector<std::string> errors;
+    JsonSeqParser parser([&](const std::string& json) {
+        received.push_back(json);
+    }, [&](const std::string& error) {
+        errors.push_back(error);
+    });
+    // 记录外的字节忽略；消息结束即交付，不必等待下一个 RS
+    parser.addData("junk\x1e{\"a\":\n  1}\n");
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":\n  1}"}), received);
+    parser.addData("\x1e{\"b\":[1,\x1e[\"c\"]\n\x1e");
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":\n  1}", "[\"c\"]"}), received);
+    EXPECT_EQ(1u, errors.size());
+    parser.addData("{\"d\":");
+    parser.finish();
+    EXPECT_EQ(2u, errors.size());
+}
+
+TEST(JsonSeqParserTest, ScalarRecordsDelivered) {
+    const std::string stream =
+        "\x1e" "42\n" "\x1e" " \"x{[\\\"\"\n" "\x1e" "true\n" "\x1e" "-1.5e3 \r\n" "\x1e" "null\n" "\x1e" "{\"a\":1}\n";
+    const std::vector<std::string> expected = {"42", "\"x{[\\\"\"", "true", "-1.5e3", "null", "{\"a\":1}"};
+    for (size_t chunk : {stream.size(), size_t(1), size_t(3)}) {
+        std::vector<std::string> received;
+        std::vector<std::string> errors;
+        JsonSeqParser parser([&](const std::string& json) {
+            received.push_back(json);
+        }, [&](const std::string& error) {
+            errors.push_back(error);
+        });
+        for (size_t pos = 0; pos < stream.size(); pos += chunk) {
+            parser.addData(stream.substr(pos, chunk));
+        }
+        parser.finish();
+        EXPECT_EQ(expected, received) << "chunk " << chunk;
+        EXPECT_TRUE(errors.empty()) << "chunk " << chunk;
+        EXPECT_EQ(expected.size(), parser.stats().messages);
+    }
+}
+
+TEST(JsonSeqParserTest, TruncatedScalarRecordReported) {
+    std::vector<std::string> received;
+    std::vector<std::string> errors;
+    JsonSeqParser parser([&](const std::string& json) {
+        received.push_back(json);
+    }, [&](const std::string& error) {
+        errors.push_back(error);
+    });
+    // 标量记录在 LF 之前遇到下一个 RS
+    parser.addData("\x1e" "12" "\x1e" "34\n");
+    EXPECT_EQ((std::vector<std::string>{"34"}), received);
+    EXPECT_EQ(1u, errors.size());
+
+    // 超长的标量记录在找到 LF 之前丢弃
+    parser.setMaxMessageSize(8);
+    parser.addData("\x1e" "\"0123456789");
+    EXPECT_EQ(2u, errors.size());
+    parser.addData("abc\"\n" "\x1e" "5\n");
+    EXPECT_EQ((std::vector<std::string>{"34", "5"}), received);
+
+    // 输入结束时没有 LF 的标量
+    parser.addData("\x1e" "99");
+    parser.finish();
+    EXPECT_EQ(3u, errors.size());
+    EXPECT_EQ(3u, parser.stats().errors);
+    EXPECT_EQ(2u, parser.stats().messages);
+}
+
+// 批量回调：所有解析器每次输入交付一批，视图在回调期间有效
+class JsonBatchCallbackTest : public JsonParserParamTest {
+protected:
+    void SetUp() override {
+        expected = makeMessages(2000, 300);
+        stream = encodeMessages(GetParam(), expected);
+        parser = JsonParserFactory::createBatchParser(GetParam(), [this](const JsonFrame* frames, size_t count) {
+            ++batches;
+            for (size_t i = 0; i < count; ++i) {
+                received.push_back(frames[i].toString());
+            }
+        }, collectErrors(), 64);
+    }
+
+    std::string stream;
+    std::vector<std::string> expected;
+    size_t batches = 0;
+};
+
+TEST_P(JsonBatchCallbackTest, DeliversInBatches) {
+    for (size_t pos = 0; pos < stream.size(); pos += 40000) {
+        parser->addData(stream.data() + pos, std::min<size_t>(40000, stream.size() - pos));
+    }
+    parser->finish();
+    EXPECT_EQ(expected, received);
+    EXPECT_GT(batches, 0u);
+    EXPECT_LT(batches, expected.size() / 4);
+    EXPECT_TRUE(errors.empty());
+}
+
+TEST_P(JsonBatchCallbackTest, MinifiedBatch) {
+    parser->setMinify(true);
+    std::vector<std::string> messages = {"{ \"a\" : 1 }", "[ 1, 2 ]", "{\"s\" : \" x \"}"};
+    parser->addData(encodeMessages(GetParam(), messages));
+    parser->finish();
+    EXPECT_EQ((std::vector<std::string>{"{\"a\":1}", "[1,2]", "{\"s\":\" x \"}"}), received);
+    EXPECT_EQ(1u, batches);
+}
+
+TEST_P(JsonBatchCallbackTest, ExceptionReportedOncePerBatch) {
+    parser->setBatchCallback([&](const JsonFrame*, size_t) {
+        ++batches;
+        throw std::runtime_error("batch failed");
+    });
+    parser->addData(stream);
+    parser->finish();
+    // 分段解析器在归还分段前会提前交付，一次输入可能分成几批
+    EXPECT_EQ(batches, errors.size());
+    EXPECT_LT(batches, expected.size() / 4);
+    EXPECT_EQ("batch failed", errors[0]);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllParsers, JsonBatchCallbackTest,
+    ::testing::Values(JsonParserFactory::ParserType::INCREMENTAL, JsonParserFactory::ParserType::RING_BUFFER,
+                      JsonParserFactory::ParserType::NDJSON, JsonParserFactory::ParserType::LENGTH_PREFIXED,
+                      JsonParserFactory::ParserType::JSON_SEQ));
+
+TEST(JsonInlineParserTest, FramesAndPropagatesExceptions) {
+    std::vector<std::string> received;
+    auto parser = makeJsonInlineParser([&](const JsonView& json) {
+        if (json.size == 3) throw std::runtime_error("bad");
+        received.push_back(json.toString());
+    });
+    std::string stream;
+    std::vector<std::string> expected = makeMessages(500, 1);
+    for (const auto& msg : expected) {
+        stream += msg + "\n";
+    }
+    std::mt19937 rng(5);
+    size_t pos = 0;
+    while (pos < stream.size()) {
+        size_t n = std::min(stream.size() - pos, size_t(1 + rng() % 200));
+        parser.addData(stream.data() + pos, n);
+        pos += n;
+    }
+    EXPECT_EQ(expected, received);
+
+    // 异常传给调用方，之后从下一条继续
+    EXPECT_THROW(parser.addData("[1]{\"a\":1}"), std::runtime_error);
+    parser.addData("");
+    std::memcpy(parser.prepare(1), " ", 1);
+    parser.commit(1);
+    EXPECT_EQ("{\"a\":1}", received.back());
+}
+
+// 统计计数：各解析器对输入字节、消息、错误与耗时的统计
+class JsonParserStatsTest : public JsonParserParamTest {
+protected:
+    void SetUp() override {
+        std::vector<std::string> messages = makeMessages(400, 100);
+        bad = messages[7];
+        stream = encodeMessages(GetParam(), messages);
+        parser = JsonParserFactory::createViewParser(GetParam(), [this](const JsonFrame& frame) {
+            ++delivered;
+            if (frame.toString() == bad) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                throw std::runtime_error("bad");
+            }
+        }, collectErrors(), 64);
+    }
+
+    std::string stream;
+    std::string bad;
+    size_t delivered = 0;
+};
+
+TEST_P(JsonParserStatsTest, CountsInputMessagesAndErrors) {
+    parser->setTiming(true);
+    for (size_t pos = 0; pos < stream.size(); pos += 1000) {
+        parser->addData(stream.data() + pos, std::min<size_t>(1000, stream.size() - pos));
+    }
+    parser->finish();
+
+    JsonParserStats st = parser->stats();
+    EXPECT_EQ(stream.size(), st.bytes_in);
+    EXPECT_EQ(400u, st.messages);
+    EXPECT_EQ(400u, delivered);
+    EXPECT_EQ(1u, st.errors);
+    EXPECT_GT(st.buffer_resizes, 0u);
+    EXPECT_GE(st.bytes_copied, stream.size() - 1000);
+    EXPECT_GT(st.peak_buffered, 0u);
+    EXPECT_LE(st.peak_buffered, 2000u);
+    EXPECT_GE(st.callback_ns, 2000000u);
+    EXPECT_GT(st.framing_ns, 0u);
+
+    parser->resetStats();
+    EXPECT_EQ(0u, parser->stats().bytes_in);
+    EXPECT_EQ(0u, parser->stats().callback_ns);
+}
+
+TEST_P(JsonParserStatsTest, ParseFileAndPrepareCommit) {
+    std::string path = ::testing::TempDir() + "json_stats_test.bin";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << stream.substr(100);
+    }
+    std::memcpy(parser->prepare(100), stream.data(), 100);
+    parser->commit(100);
+    ASSERT_TRUE(parser->parseFile(path));
+    std::remove(path.c_str());
+    parser->finish();
+
+    JsonParserStats st = parser->stats();
+    EXPECT_EQ(stream.size(), st.bytes_in);
+    EXPECT_EQ(400u, st.messages);
+    // 不开启计时时不统计耗时
+    EXPECT_EQ(0u, st.callback_ns);
+    EXPECT_EQ(0u, st.framing_ns);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllParsers, JsonParserStatsTest,
+    ::testing::Values(JsonParserFactory::ParserType::INCREMENTAL, JsonParserFactory::ParserType::RING_BUFFER,
+                      JsonParserFactory::ParserType::NDJSON, JsonParserFactory::ParserType::LENGTH_PREFIXED,
+                      JsonParserFactory::ParserType::JSON_SEQ));
+
 // Test for the parser factory
 TEST(JsonParserFactoryTest, CreateIncrementalParser) {
     auto parser = JsonParserFactory::createParser(
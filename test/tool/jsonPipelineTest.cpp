@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+#include "jsonPipeline.h"
+#include "jsonQuery.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+static std::string makeStream(size_t count) {
+    std::string data;
+    for (size_t i = 0; i < count; ++i) {
+        data += "{\"id\":" + std::to_string(i) + ",\"text\":\"{[\\\"" + std::to_string(i) + "\"}\n";
+    }
+    return data;
+}
+
+// 处理函数：取出 id
+static bool extractId(const std::string& json, int64_t& out) {
+    JsonNumber n;
+    if (!JsonQuery::getNumber(JsonView(json.data(), json.size()), "/id", n)) return false;
+    out = n.toInt64();
+    return true;
+}
+
+static std::vector<int64_t> expectedIds(size_t count) {
+    std::vector<int64_t> ids;
+    for (size_t i = 0; i < count; ++i) ids.push_back(static_cast<int64_t>(i));
+    return ids;
+}
+
+TEST(JsonPipelineTest, FeedDeliversAllMessages) {
+    JsonPipelineConfig config;
+    config.worker_threads = 3;
+    config.batch_size = 7;
+    config.queue_batches = 2;
+    std::vector<int64_t> ids;
+    JsonPipeline<int64_t> pipeline(config, extractId, [&](int64_t& id) {
+        ids.push_back(id);   // 单个输出线程，无需加锁
+    });
+    pipeline.start();
+
+    std::string data = makeStream(1000);
+    for (size_t pos = 0; pos < data.size(); pos += 333) {
+        pipeline.feed(data.data() + pos, std::min<size_t>(333, data.size() - pos));
+    }
+    pipeline.close();
+
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(expectedIds(1000), ids);
+
+    std::vector<JsonPipelineStageStats> stats = pipeline.stats();
+    ASSERT_EQ(3u, stats.size());
+    EXPECT_EQ("source", stats[0].name);
+    EXPECT_EQ(1000u, stats[0].items);
+    EXPECT_EQ(1000u, stats[1].items);
+    EXPECT_EQ(3u, stats[1].threads);
+    EXPECT_EQ(1000u, stats[2].items);
+    EXPECT_EQ((1000u + 6) / 7, stats[1].batches);
+    EXPECT_LE(stats[1].input.high_water, 2u);
+    EXPECT_GT(stats[1].throughput(), 0.0);
+}
+
+TEST(JsonPipelineTest, BackpressureBlocksSource) {
+    JsonPipelineConfig config;
+    config.worker_threads = 1;
+    config.batch_size = 1;
+    config.queue_batches = 1;
+    std::atomic<size_t> handled(0);
+    std::atomic<size_t> sunk(0);
+    JsonPipeline<int64_t> pipeline(config, [&](const std::string& json, int64_t& out) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ++handled;
+        return extractId(json, out);
+    }, [&](int64_t&) {
+        ++sunk;
+    });
+    pipeline.start();
+    pipeline.feed(makeStream(20));
+    // feed 返回时最多还有：处理中 1 批 + 队列中 1 批 + 已交给输出阶段的部分
+    EXPECT_GE(handled.load(), 18u);
+    pipeline.close();
+    EXPECT_EQ(20u, sunk.load());
+    EXPECT_GT(pipeline.stats()[1].input.producer_blocked_ns, 0u);
+}
+
+TEST(JsonPipelineTest, FilteredMessagesAndErrors) {
+    JsonPipelineConfig config;
+    config.worker_threads = 2;
+    config.batch_size = 4;
+    std::mutex mutex;
+    std::vector<std::string> errors;
+    std::atomic<size_t> sunk(0);
+    JsonPipeline<int64_t> pipeline(config, [](const std::string& json, int64_t& out) {
+        if (!extractId(json, out)) return false;
+        if (out == 5) throw std::runtime_error("bad id");
+        return out % 2 == 0;
+    }, [&](int64_t&) {
+        ++sunk;
+    }, [&](const std::string& error) {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.push_back(error);
+    });
+    pipeline.feed(makeStream(10));
+    pipeline.close();
+    EXPECT_EQ(5u, sunk.load());
+    ASSERT_EQ(1u, errors.size());
+    EXPECT_EQ("bad id", errors[0]);
+}
+
+TEST(JsonPipelineTest, FileAndFdSources) {
+    std::string data = makeStream(500);
+    std::string path = "jsonPipelineTest.ndjson";
+    {
+        std::ofstream out(path.c_str(), std::ios::binary);
+        out << data;
+    }
+
+    JsonPipelineConfig config;
+    config.worker_threads = 2;
+    config.sink_threads = 2;
+    config.read_chunk = 100;
+    config.parser_type = JsonParserFactory::ParserType::RING_BUFFER;
+    std::mutex mutex;
+    std::vector<int64_t> ids;
+    JsonPipeline<int64_t> pipeline(config, extractId, [&](int64_t& id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ids.push_back(id);
+    });
+    pipeline.start();
+    ASSERT_TRUE(pipeline.runFile(path));
+
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    std::thread writer([&]() {
+        size_t pos = 0;
+        while (pos < data.size()) {
+            ssize_t n = ::write(fds[1], data.data() + pos, std::min<size_t>(1000, data.size() - pos));
+            if (n <= 0) break;
+            pos += static_cast<size_t>(n);
+        }
+        ::close(fds[1]);
+    });
+    EXPECT_TRUE(pipeline.runFd(fds[0]));
+    writer.join();
+    ::close(fds[0]);
+    pipeline.close();
+    std::remove(path.c_str());
+
+    std::vector<int64_t> expected = expectedIds(500);
+    expected.insert(expected.end(), expected.begin(), expected.end());
+    std::sort(expected.begin(), expected.end());
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(expected, ids);
+}
+
+TEST(JsonPipelineTest, StatsFromMonitorThreadDuringClose) {
+    JsonPipelineConfig config;
+    config.worker_threads = 2;
+    config.sink_threads = 2;
+    config.batch_size = 16;
+    std::atomic<size_t> errors(0);
+    std::atomic<size_t> sunk(0);
+    JsonPipeline<int64_t> pipeline(config, [](const std::string& json, int64_t& out) {
+        if (!extractId(json, out)) return false;
+        if (out % 100 == 0) throw std::runtime_error("bad id");
+        return true;
+    }, [&](int64_t&) {
+        ++sunk;
+    }, [&](const std::string&) {
+        ++errors;
+    });
+    pipeline.start();
+    pipeline.feed(makeStream(5000));
+
+    // 监控线程在 close() 期间读取统计，运行时长不得为 0
+    std::atomic<bool> done(false);
+    std::thread monitor([&]() {
+        while (!done) {
+            for (const auto& st : pipeline.stats()) {
+                EXPECT_GT(st.elapsed_s, 0.0);
+            }
+        }
+    });
+    pipeline.close();
+    done = true;
+    monitor.join();
+
+    EXPECT_EQ(50u, errors.load());
+    EXPECT_EQ(4950u, sunk.load());
+    std::vector<JsonPipelineStageStats> stats = pipeline.stats();
+    EXPECT_GT(stats[0].elapsed_s, 0.0);
+    EXPECT_EQ(5000u, stats[1].items);
+}
+
+TEST(JsonPipelineTest, CloseWithoutStart) {
+    JsonPipelineConfig config;
+    config.worker_threads = 1;
+    size_t sunk = 0;
+    JsonPipeline<int64_t> pipeline(config, extractId, [&](int64_t&) {
+        ++sunk;
+    });
+    pipeline.feed(makeStream(3));
+    pipeline.close();
+    pipeline.close();
+    EXPECT_EQ(3u, sunk);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "jsonQuery.h"
+#include "jsonDom.h"
+#include <string>
+#include <vector>
+
+static std::string query(const std::string& msg, const char* pointer) {
+    return JsonQuery::get(JsonView(msg.data(), msg.size()), pointer).toString();
+}
+
+TEST(JsonQueryTest, TopLevelAndNestedMembers) {
+    std::string msg = R"( {"header":{"type":"trade","seq":42,"tags":["a","b"]},
+                           "body":{"skip":[{"x":"}]\"{"},[[1,2],[3]]],"price":101.5,"ok":true,"none":null}} )";
+    EXPECT_EQ("\"trade\"", query(msg, "/header/type"));
+    EXPECT_EQ("42", query(msg, "/header/seq"));
+    EXPECT_EQ("[\"a\",\"b\"]", query(msg, "/header/tags"));
+    EXPECT_EQ("\"b\"", query(msg, "/header/tags/1"));
+    EXPECT_EQ("101.5", query(msg, "/body/price"));
+    EXPECT_EQ("true", query(msg, "/body/ok"));
+    EXPECT_EQ("null", query(msg, "/body/none"));
+    EXPECT_EQ("3", query(msg, "/body/skip/1/1/0"));
+    EXPECT_EQ("\"}]\\\"{\"", query(msg, "/body/skip/0/x"));
+
+    // 空指针返回整条消息（去掉前导空白）
+    std::string whole = query(msg, "");
+    EXPECT_EQ('{', whole.front());
+    EXPECT_EQ('}', whole.back());
+}
+
+TEST(JsonQueryTest, MissingPathsReturnEmpty) {
+    std::string msg = R"({"a":{"b":[1,2]},"c":"x"})";
+    EXPECT_EQ("", query(msg, "/missing"));
+    EXPECT_EQ("", query(msg, "/a/missing"));
+    EXPECT_EQ("", query(msg, "/a/b/2"));
+    EXPECT_EQ("", query(msg, "/a/b/01"));
+    EXPECT_EQ("", query(msg, "/a/b/-"));
+    // 2^64 + 1，不得回绕成下标 1
+    EXPECT_EQ("", query(msg, "/a/b/18446744073709551617"));
+    EXPECT_EQ("", query(msg, "/a/b/99999999999999999999"));
+    EXPECT_EQ("", query(msg, "/c/x"));
+    EXPECT_EQ("", query(msg, "a"));
+    EXPECT_EQ("", query("{\"a\":", "/a"));
+    EXPECT_EQ("", query("{\"a\":[1,2", "/a"));
+}
+
+TEST(JsonQueryTest, EscapedKeysAndPointerTokens) {
+    std::string msg = R"({"a/b":1,"m~n":2,"q\"k":3,"c":4,"":5})";
+    EXPECT_EQ("1", query(msg, "/a~1b"));
+    EXPECT_EQ("2", query(msg, "/m~0n"));
+    EXPECT_EQ("3", query(msg, "/q\"k"));
+    EXPECT_EQ("4", query(msg, "/c"));
+    EXPECT_EQ("5", query(msg, "/"));
+
+    // 多层含 ~ 的 token，键中含转义
+    std::string nested = R"({"x":0,"a/b~":{"y":1,"p\/q~":{"z~":7}}})";
+    EXPECT_EQ("7", query(nested, "/a~1b~0/p~1q~0/z~0"));
+    EXPECT_EQ("", query(nested, "/a~1b~0/p~1q/z~0"));
+}
+
+TEST(JsonQueryTest, GetStringUnescapes) {
+    std::string msg = R"({"user":{"name":"A\"Bé"},"n":1})";
+    JsonView view(msg.data(), msg.size());
+    std::string name;
+    ASSERT_TRUE(JsonQuery::getString(view, "/user/name", name));
+    EXPECT_EQ("A\"B\xc3\xa9", name);
+    EXPECT_FALSE(JsonQuery::getString(view, "/n", name));
+    EXPECT_TRUE(JsonQuery::contains(view, "/n"));
+    EXPECT_FALSE(JsonQuery::contains(view, "/m"));
+}
+
+TEST(JsonQueryTest, WrappedFrame) {
+    std::string msg = R"({"header":{"type":"quote"},"v":1})";
+    JsonFrame frame(JsonView(msg.data(), 10), JsonView(msg.data() + 10, msg.size() - 10));
+    std::string scratch;
+    EXPECT_EQ("\"quote\"", JsonQuery::get(frame, "/header/type", scratch).toString());
+}
+
+// 与 DOM 的结果对比：每个成员都能按路径取到与 DOM 一致的原始文本
+static void collectPaths(const JsonValue& value, const std::string& path, std::vector<std::pair<std::string, const JsonValue*>>& out) {
+    out.push_back(std::make_pair(path, &value));
+    size_t index = 0;
+    for (const JsonValue& child : value) {
+        std::string next = path + "/" + (value.isObject() ? child.getKey() : std::to_string(index));
+        collectPaths(child, next, out);
+        ++index;
+    }
+}
+
+TEST(JsonQueryTest, AgreesWithDom) {
+    std::string msg = R"({"id":7,"items":[{"k":"v1","n":[1,{"deep":"x"}]},{"k":"v2","n":[]}],
+                          "meta":{"s":"[{\"","e":{},"f":-0.5e3}})";
+    JsonDocument doc;
+    ASSERT_TRUE(doc.parse(msg.data(), msg.size()));
+
+    std::vector<std::pair<std::string, const JsonValue*>> paths;
+    collectPaths(*doc.root(), "", paths);
+    ASSERT_GT(paths.size(), 15u);
+    for (const auto& entry : paths) {
+        std::string raw = query(msg, entry.first.c_str());
+        ASSERT_FALSE(raw.empty()) << entry.first;
+        const JsonValue* v = entry.second;
+        if (v->isString()) {
+            EXPECT_EQ("\"" + v->rawString().toString() + "\"", raw) << entry.first;
+        } else if (v->isNumber()) {
+            EXPECT_EQ(v->rawNumber().toString(), raw) << entry.first;
+        } else {
+            JsonDocument sub;
+            EXPECT_TRUE(sub.parse(raw.data(), raw.size())) << entry.first;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
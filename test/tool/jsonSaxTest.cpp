@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+#include "jsonSax.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// 统计全局 operator new 的调用次数，用于验证稳态解析不分配内存
+static std::atomic<size_t> g_allocations(0);
+
+void* operator new(size_t size) {
+    ++g_allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+// 把事件记录成一行文本，便于比较
+class RecordingHandler : public JsonSaxHandler {
+    public:
+        bool startObject() override { out += "{"; return true; }
+        bool endObject() override { out += "}"; return true; }
+        bool startArray() override { out += "["; return true; }
+        bool endArray() override { out += "]"; return true; }
+        bool key(const JsonView& name) override { out += "k(" + name.toString() + ")"; return true; }
+        bool string(const JsonView& value) override { out += "s(" + value.toString() + ")"; return true; }
+        bool number(const JsonView& raw) override { out += "n(" + raw.toString() + ")"; return true; }
+        bool boolean(bool value) override { out += value ? "T" : "F"; return true; }
+        bool nullValue() override { out += "N"; return true; }
+        void endDocument() override { out += "|"; ++documents; }
+
+        std::string out;
+        size_t documents = 0;
+};
+
+static const char* kSample =
+    "{\"id\":-12.5e+3,\"name\":\"a\\\"b\\u00e9\\ud83d\\ude00\",\"ok\":true,\"no\":false,\"nil\":null,"
+    "\"list\":[1,[],{},[0,\"x\"]],\"obj\":{\"k\":\"}\"}}\n[true,null]  {\"e\":{}}";
+
+static const char* kExpected =
+    "{k(id)n(-12.5e+3)k(name)s(a\"b\xc3\xa9\xf0\x9f\x98\x80)k(ok)Tk(no)Fk(nil)N"
+    "k(list)[n(1)[]{}[n(0)s(x)]]k(obj){k(k)s(})}}|[TN]|{k(e){}}|";
+
+TEST(JsonSaxParserTest, EventsForWholeInput) {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    parser.addData(kSample);
+    EXPECT_EQ(kExpected, handler.out);
+    EXPECT_EQ(3u, handler.documents);
+    EXPECT_FALSE(parser.inDocument());
+}
+
+TEST(JsonSaxParserTest, EveryTwoWaySplitGivesSameEvents) {
+    std::string input = kSample;
+    for (size_t cut = 0; cut <= input.size(); ++cut) {
+        RecordingHandler handler;
+        JsonSaxParser parser(handler);
+        parser.addData(input.data(), cut);
+        parser.addData(input.data() + cut, input.size() - cut);
+        EXPECT_EQ(kExpected, handler.out) << "cut at " << cut;
+    }
+}
+
+TEST(JsonSaxParserTest, ByteByByte) {
+    RecordingHandler handler;
+    JsonSaxParser parser(handler);
+    std::string input = kSample;
+    for (char c : input) {
+        parser.addData(&c, 1);
+    }
+    EXPECT_EQ(kExpected, handler.out);
+}
+
+TEST(JsonSaxParserTest, RandomChunks) {
+    std::string input;
+    for (int i = 0; i < 20; ++i) {
+        input += kSample;
+        input += "\n";
+    }
+    std::string expected;
+    for (int i = 0; i < 20; ++i) {
+        expected += kExpected;
+    }
+
+    std::mt19937 rng(7);
+    for (int round = 0; round < 50; ++round) {
+        RecordingHandler handler;
+        JsonSaxParser parser(handler);
+        size_t pos = 0;
+        while (pos < input.size()) {
+            size_t n = std::min(input.size() - pos, size_t(1 + rng() % 40));
+            parser.addData(input.data() + pos, n);
+            pos += n;
+        }
+        ASSERT_EQ(expected, handler.out);
+    }
+}
+
+TEST(JsonSaxParserTest, ErrorsAreReportedAndParserRecovers) {
+    const char* bad[] = {
+        "{\"a\" 1}", "[1,]", "{\"a\":1,}", "[01]", "[1.]", "[-]", "tru ", "\"a\\x\"",
+        "\"\\u12g4\"", "{1:2}", "[1 2]", "[}", "{]", "\"a\tb\""
+    };
+    for (const char* text : bad) {
+        RecordingHandler handler;
+        std::vector<std::string> errors;
+        JsonSaxParser parser(handler, [&](const std::string& e) { errors.push_back(e); });
+        parser.addData(text);
+        EXPECT_EQ(1u, errors.size()) << text;
+        EXPECT_EQ(0u, handler.documents) << text;
+
+        // 下一个数据块从干净状态开始
+        parser.addData("{\"a\":1}");
+        EXPECT_EQ(1u, handler.documents) << text;
+    }
+}
+
+TEST(JsonSaxParserTest, FinishFlushesTrailingNumber) {
+    RecordingHandler handler;
+    std::vector<std::string> errors;
+    JsonSaxParser parser(handler, [&](const std::string& e) { errors.push_back(e); });
+    parser.addData("1 -2.5");
+    parser.addData("e3");
+    EXPECT_EQ("n(1)|", handler.out);
+    parser.finish();
+    EXPECT_EQ("n(1)|n(-2.5e3)|", handler.out);
+    EXPECT_TRUE(errors.empty());
+    EXPECT_FALSE(parser.inDocument());
+
+    // 单独一个数字的流
+    parser.addData("42");
+    parser.finish();
+    EXPECT_EQ("n(1)|n(-2.5e3)|n(42)|", handler.out);
+    EXPECT_EQ(3u, handler.documents);
+
+    // 完整消息之后调用 finish() 不产生事件
+    parser.finish();
+    EXPECT_EQ(3u, handler.documents);
+    EXPECT_TRUE(errors.empty());
+
+    // 末尾的无效数字在 finish() 时报错
+    parser.addData("1e");
+    parser.finish();
+    EXPECT_EQ(1u, errors.size());
+    EXPECT_EQ(3u, handler.documents);
+}
+
+TEST(JsonSaxParserTest, FinishReportsUnterminatedDocument) {
+    const char* partial[] = {"{\"a\":[1,2", "[1", "\"abc", "tr", "{\"a\"", "[-"};
+    for (const char* text : partial) {
+        RecordingHandler handler;
+        std::vector<std::string> errors;
+        JsonSaxParser parser(handler, [&](const std::string& e) { errors.push_back(e); });
+        parser.addData(text);
+        EXPECT_TRUE(errors.empty()) << text;
+        parser.finish();
+        EXPECT_EQ(1u, errors.size()) << text;
+        EXPECT_EQ(0u, handler.documents) << text;
+        EXPECT_FALSE(parser.inDocument()) << text;
+
+        // 之后的输入从干净状态开始
+        parser.addData("{\"a\":1}");
+        EXPECT_EQ(1u, handler.documents) << text;
+    }
+}
+
+TEST(JsonSaxParserTest, DepthLimit) {
+    RecordingHandler handler;
+    std::vector<std::string> errors;
+    JsonSaxParser parser(handler, [&](const std::string& e) { errors.push_back(e); }, 8);
+    parser.addData("[[[[[[[[[1]]]]]]]]]");
+    EXPECT_EQ(1u, errors.size());
+}
+
+// 只提取三个字段的处理器，不保存任何字符串
+class FieldPicker : public JsonSaxHandler {
+    public:
+        bool startObject() override { ++depth; return true; }
+        bool endObject() override { --depth; return true; }
+        bool key(const JsonView& name) override {
+            current = depth == 1 ? matchKey(name) : -1;
+            return true;
+        }
+        bool number(const JsonView& raw) override {
+            if (current == 0) id = std::strtoll(raw.data, nullptr, 10);
+            if (current == 2) price_digits = raw.size;
+            return true;
+        }
+        bool string(const JsonView& value) override {
+            if (current == 1) type_len = value.size;
+            return true;
+        }
+        void endDocument() override { ++documents; }
+
+        static int matchKey(const JsonView& name) {
+            if (name.size == 2 && std::memcmp(name.data, "id", 2) == 0) return 0;
+            if (name.size == 4 && std::memcmp(name.data, "type", 4) == 0) return 1;
+            if (name.size == 5 && std::memcmp(name.data, "price", 5) == 0) return 2;
+            return -1;
+        }
+
+        int depth = 0;
+        int current = -1;
+        long long id = 0;
+        size_t type_len = 0;
+        size_t price_digits = 0;
+        size_t documents = 0;
+};
+
+TEST(JsonSaxParserTest, ExtractFieldsWithoutAllocation) {
+    std::string message = "{\"id\":12345,\"type\":\"trade\",\"payload\":[";
+    while (message.size() < 4000) {
+        message += "{\"k\":\"value with \\\"escape\\\"\",\"v\":[1.5,2,3,true,null]},";
+    }
+    message += "0],\"price\":101.25}";
+
+    FieldPicker picker;
+    JsonSaxParser parser(picker);
+    // 预热：让暂存区和容器栈达到所需容量
+    parser.addData(message.data(), 1000);
+    parser.addData(message.data() + 1000, message.size() - 1000);
+    ASSERT_EQ(1u, picker.documents);
+
+    size_t before = g_allocations.load();
+    for (int i = 0; i < 10; ++i) {
+        parser.addData(message.data(), 1000);
+        parser.addData(message.data() + 1000, message.size() - 1000);
+    }
+    EXPECT_EQ(before, g_allocations.load());
+    EXPECT_EQ(11u, picker.documents);
+    EXPECT_EQ(12345, picker.id);
+    EXPECT_EQ(5u, picker.type_len);
+    EXPECT_EQ(6u, picker.price_digits);
+}
+
+TEST(JsonSaxParserTest, HandlerCanAbort) {
+    class Abort : public JsonSaxHandler {
+        public:
+            bool key(const JsonView&) override { return false; }
+    } handler;
+    size_t errors = 0;
+    JsonSaxParser parser(handler, [&](const std::string&) { ++errors; });
+    parser.addData("{\"a\":1}");
+    EXPECT_EQ(1u, errors);
+    EXPECT_FALSE(parser.inDocument());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
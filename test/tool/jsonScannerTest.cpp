@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "jsonScanner.h"
+#include "jsonParser.h"
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// 逐字节计算的参考位图
+static JsonBlockMasks referenceMasks(const char* p, size_t len) {
+    JsonBlockMasks masks;
+    for (size_t i = 0; i < len; ++i) {
+        const uint64_t bit = uint64_t(1) << i;
+        switch (p[i]) {
+            case '"':  masks.quote |= bit; break;
+            case '\\': masks.backslash |= bit; break;
+            case '{':
+            case '[':  masks.open |= bit; break;
+            case '}':
+            case ']':  masks.close |= bit; break;
+            default: break;
+        }
+    }
+    return masks;
+}
+
+static void expectSameMasks(const JsonBlockMasks& expected, const JsonBlockMasks& actual) {
+    EXPECT_EQ(expected.quote, actual.quote);
+    EXPECT_EQ(expected.backslash, actual.backslash);
+    EXPECT_EQ(expected.open, actual.open);
+    EXPECT_EQ(expected.close, actual.close);
+}
+
+TEST(JsonStructuralScannerTest, KnownBlock) {
+    std::string block = "{\"a\":[1,2],\"b\":\"x\\\"y\"}";
+    block.resize(JsonStructuralScanner::BLOCK_SIZE, ' ');
+
+    JsonBlockMasks masks;
+    JsonStructuralScanner::scanBlock(block.data(), masks);
+    expectSameMasks(referenceMasks(block.data(), block.size()), masks);
+    EXPECT_EQ(uint64_t(1) << 0 | uint64_t(1) << 5, masks.open);
+}
+
+TEST(JsonStructuralScannerTest, RandomBlocksMatchReference) {
+    const char alphabet[] = "{}[]\"\\ ,:abc01\n\x7b\x5b\x7d\x5d\xfb\xdb";
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+
+    for (int round = 0; round < 2000; ++round) {
+        char block[JsonStructuralScanner::BLOCK_SIZE];
+        for (size_t i = 0; i < sizeof(block); ++i) {
+            block[i] = alphabet[pick(rng)];
+        }
+        JsonBlockMasks masks;
+        JsonStructuralScanner::scanBlock(block, masks);
+        expectSameMasks(referenceMasks(block, sizeof(block)), masks);
+
+        size_t tail = round % JsonStructuralScanner::BLOCK_SIZE;
+        JsonStructuralScanner::scanTail(block, tail, masks);
+        expectSameMasks(referenceMasks(block, tail), masks);
+    }
+}
+
+TEST(JsonStructuralScannerTest, TrackerScanMatchesProcessChar) {
+    std::string input;
+    for (int i = 0; i < 50; ++i) {
+        input += "{\"id\":" + std::to_string(i) + ",\"v\":[1,[2,{\"k\":3}]]}  \n";
+    }
+
+    // 逐字节处理得到的参考结束位置
+    std::vector<size_t> expected;
+    JsonStateTtacker ref;
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (ref.processChar(input[i])) {
+            expected.push_back(i + 1);
+            ref.reset();
+        }
+    }
+
+    std::vector<size_t> actual;
+    JsonStateTtacker tracker;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        pos += tracker.scan(input.data() + pos, input.size() - pos);
+        if (tracker.isComplete()) {
+            actual.push_back(pos);
+            tracker.reset();
+        }
+    }
+    EXPECT_EQ(expected, actual);
+}
+
+// 随机生成包含字符串、转义和括号的合法JSON
+static void randomValue(std::mt19937& rng, int depth, std::string& out) {
+    std::uniform_int_distribution<int> kind(0, depth > 4 ? 1 : 3);
+    switch (kind(rng)) {
+        case 0: {
+            out += std::to_string(rng() % 1000);
+            break;
+        }
+        case 1: {
+            static const char* pieces[] = {"a", "}", "]", "{", "[", "\\\\", "\\\"", " ", "\\n", "\xe4\xb8\xad"};
+            out += '"';
+            int len = rng() % 12;
+            for (int i = 0; i < len; ++i) {
+                out += pieces[rng() % (sizeof(pieces) / sizeof(pieces[0]))];
+            }
+            out += '"';
+            break;
+        }
+        case 2: {
+            out += '[';
+            int len = rng() % 4;
+            for (int i = 0; i < len; ++i) {
+                if (i) out += ',';
+                randomValue(rng, depth + 1, out);
+            }
+            out += ']';
+            break;
+        }
+        default: {
+            out += '{';
+            int len = rng() % 4;
+            for (int i = 0; i < len; ++i) {
+                if (i) out += ',';
+                out += "\"k" + std::to_string(i) + "\\\"}\":";
+                randomValue(rng, depth + 1, out);
+            }
+            out += '}';
+            break;
+        }
+    }
+}
+
+TEST(JsonStructuralScannerTest, StringAwareScanMatchesProcessChar) {
+    std::mt19937 rng(2024);
+    for (int round = 0; round < 200; ++round) {
+        std::string input;
+        for (int i = 0; i < 20; ++i) {
+            bool object = rng() % 2;
+            input += object ? "{\"v\":" : "[";
+            randomValue(rng, 0, input);
+            input += object ? "}" : "]";
+            input += (rng() % 3) ? "\n" : "";
+        }
+
+        std::vector<size_t> expected;
+        JsonStateTtacker ref;
+        for (size_t i = 0; i < input.size(); ++i) {
+            if (ref.processChar(input[i])) {
+                expected.push_back(i + 1);
+                ref.reset();
+            }
+        }
+        ASSERT_EQ(20u, expected.size());
+
+        // 随机切分成多段喂入，验证跨块、跨调用的字符串和转义状态
+        std::vector<size_t> actual;
+        JsonStateTtacker tracker;
+        size_t pos = 0;
+        while (pos < input.size()) {
+            size_t chunk_end = std::min(input.size(), pos + 1 + rng() % 150);
+            while (pos < chunk_end) {
+                pos += tracker.scan(input.data() + pos, chunk_end - pos);
+                if (tracker.isComplete()) {
+                    actual.push_back(pos);
+                    tracker.reset();
+                }
+            }
+        }
+        EXPECT_EQ(expected, actual) << input;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    std::cout << "JsonStructuralScanner implementation: " << JsonStructuralScanner::implementation() << std::endl;
+    return RUN_ALL_TESTS();
+}
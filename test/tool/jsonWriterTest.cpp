@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include "jsonWriter.h"
+#include "jsonNumber.h"
+#include "jsonDom.h"
+#include "jsonSax.h"
+#include "jsonParser.h"
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static std::string formatDouble(double d) {
+    char buf[32];
+    return std::string(buf, JsonNumberFormatter::formatDouble(d, buf));
+}
+
+TEST(JsonWriterTest, CompactOutput) {
+    JsonWriter writer;
+    writer.startObject();
+    writer.key("id");
+    writer.int64Value(42);
+    writer.key("name");
+    writer.string("craftrix");
+    writer.key("tags");
+    writer.startArray();
+    writer.string("a");
+    writer.boolean(true);
+    writer.nullValue();
+    writer.startObject();
+    writer.endObject();
+    writer.startArray();
+    writer.endArray();
+    writer.endArray();
+    writer.key("price");
+    writer.doubleValue(101.25);
+    writer.endObject();
+    EXPECT_EQ("{\"id\":42,\"name\":\"craftrix\",\"tags\":[\"a\",true,null,{},[]],\"price\":101.25}", writer.toString());
+    EXPECT_EQ(0u, writer.depth());
+}
+
+TEST(JsonWriterTest, PrettyOutput) {
+    JsonWriter writer(2);
+    writer.startObject();
+    writer.key("a");
+    writer.startArray();
+    writer.int64Value(1);
+    writer.int64Value(2);
+    writer.endArray();
+    writer.key("b");
+    writer.startObject();
+    writer.endObject();
+    writer.endObject();
+    EXPECT_EQ("{\n  \"a\": [\n    1,\n    2\n  ],\n  \"b\": {}\n}", writer.toString());
+}
+
+TEST(JsonWriterTest, EscapesStrings) {
+    JsonWriter writer;
+    writer.string(std::string("q\"b\\s/\b\f\n\r\t\x01\x1f\x7f\xe4\xb8\xad", 17));
+    EXPECT_EQ("\"q\\\"b\\\\s/\\b\\f\\n\\r\\t\\u0001\\u001f\x7f\xe4\xb8\xad\"", writer.toString());
+}
+
+TEST(JsonWriterTest, RandomStringsRoundTripThroughDom) {
+    std::mt19937 rng(3);
+    JsonWriter writer;
+    JsonDocument doc;
+    for (int round = 0; round < 2000; ++round) {
+        std::string value;
+        size_t len = rng() % 80;
+        for (size_t i = 0; i < len; ++i) {
+            // 偏向生成需要转义的字符，覆盖 SIMD 块内不同位置
+            value += (rng() % 4 == 0) ? static_cast<char>(rng() % 0x20) : static_cast<char>(0x20 + rng() % 0x60);
+        }
+        writer.clear();
+        writer.startArray();
+        writer.string(value);
+        writer.endArray();
+        ASSERT_TRUE(doc.parse(writer.data(), writer.size())) << writer.toString();
+        ASSERT_EQ(value, doc.root()->at(0)->getString());
+    }
+}
+
+TEST(JsonWriterTest, Integers) {
+    const int64_t signed_cases[] = {0, 1, -1, 9, 10, 99, 100, -100, 123456789, INT64_MAX, INT64_MIN};
+    for (int64_t v : signed_cases) {
+        JsonWriter writer;
+        writer.int64Value(v);
+        EXPECT_EQ(std::to_string(v), writer.toString());
+    }
+    JsonWriter writer;
+    writer.uint64Value(UINT64_MAX);
+    EXPECT_EQ(std::to_string(UINT64_MAX), writer.toString());
+
+    std::mt19937_64 rng(5);
+    char buf[32];
+    for (int i = 0; i < 100000; ++i) {
+        int64_t v = static_cast<int64_t>(rng() >> (rng() % 64));
+        ASSERT_EQ(std::to_string(v), std::string(buf, JsonNumberFormatter::formatInt64(v, buf)));
+    }
+}
+
+TEST(JsonWriterTest, DoubleFormatting) {
+    EXPECT_EQ("0.0", formatDouble(0.0));
+    EXPECT_EQ("-0.0", formatDouble(-0.0));
+    EXPECT_EQ("1.0", formatDouble(1.0));
+    EXPECT_EQ("0.1", formatDouble(0.1));
+    EXPECT_EQ("-2.5", formatDouble(-2.5));
+    EXPECT_EQ("123456.789", formatDouble(123456.789));
+    EXPECT_EQ("1e21", formatDouble(1e21));
+    EXPECT_EQ("100000000000000000000.0", formatDouble(1e20));
+    EXPECT_EQ("1.5e-7", formatDouble(1.5e-7));
+    EXPECT_EQ("0.000001", formatDouble(1e-6));
+    EXPECT_EQ("1.7976931348623157e308", formatDouble(1.7976931348623157e308));
+    EXPECT_EQ("5e-324", formatDouble(5e-324));
+    EXPECT_EQ("null", formatDouble(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ("null", formatDouble(std::numeric_limits<double>::quiet_NaN()));
+}
+
+TEST(JsonWriterTest, RandomDoublesRoundTrip) {
+    std::mt19937_64 rng(11);
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t bits = rng();
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        if (d != d || d - d != 0) continue;
+        std::string text = formatDouble(d);
+        JsonNumber n;
+        ASSERT_TRUE(JsonNumberParser::parse(text.data(), text.size(), n)) << text;
+        uint64_t back;
+        double value = n.toDouble();
+        std::memcpy(&back, &value, sizeof(back));
+        ASSERT_EQ(bits, back) << text;
+    }
+}
+
+TEST(JsonWriterTest, FixedBufferOverflow) {
+    char buf[16];
+    JsonWriter writer(buf, sizeof(buf));
+    writer.startObject();
+    writer.key("k");
+    writer.int64Value(1);
+    writer.endObject();
+    EXPECT_FALSE(writer.overflow());
+    EXPECT_EQ("{\"k\":1}", writer.toString());
+    EXPECT_EQ(buf, writer.data());
+
+    writer.clear();
+    writer.startArray();
+    writer.string("this string does not fit");
+    writer.endArray();
+    EXPECT_TRUE(writer.overflow());
+    EXPECT_LE(writer.size(), sizeof(buf));
+}
+
+TEST(JsonWriterTest, ClearReusesBuffer) {
+    JsonWriter writer(0, 16);
+    for (int i = 0; i < 100; ++i) {
+        writer.string("grow the buffer a little");
+    }
+    const char* data = writer.data();
+    size_t cap = writer.capacity();
+    for (int round = 0; round < 10; ++round) {
+        writer.clear();
+        writer.startArray();
+        writer.string("short");
+        writer.endArray();
+    }
+    EXPECT_EQ(data, writer.data());
+    EXPECT_EQ(cap, writer.capacity());
+}
+
+// SAX 事件直接转发给写入器：解析后再写出应得到压缩后的原文
+class WriterHandler : public JsonSaxHandler {
+    public:
+        explicit WriterHandler(JsonWriter& w) : writer(w) {}
+        bool startObject() override { writer.startObject(); return true; }
+        bool endObject() override { writer.endObject(); return true; }
+        bool startArray() override { writer.startArray(); return true; }
+        bool endArray() override { writer.endArray(); return true; }
+        bool key(const JsonView& name) override { writer.key(name.data, name.size); return true; }
+        bool string(const JsonView& value) override { writer.string(value); return true; }
+        bool number(const JsonView& raw) override { writer.rawValue(raw); return true; }
+        bool boolean(bool value) override { writer.boolean(value); return true; }
+        bool nullValue() override { writer.nullValue(); return true; }
+        JsonWriter& writer;
+};
+
+TEST(JsonWriterTest, SaxRoundTrip) {
+    std::string input = "{ \"a\" : [1, 2.5e3, -0, true, false, null],\n \"b\\\"c\" : {\"d\": \"x\\ty\"}, \"e\": [] }";
+    JsonWriter writer;
+    WriterHandler handler(writer);
+    JsonSaxParser parser(handler);
+    parser.addData(input);
+    EXPECT_EQ("{\"a\":[1,2.5e3,-0,true,false,null],\"b\\\"c\":{\"d\":\"x\\ty\"},\"e\":[]}", writer.toString());
+}
+
+// 写出一批消息，经两种分帧器随机切块后逐条还原
+static std::vector<std::string> writeMessages(size_t count) {
+    std::vector<std::string> messages;
+    JsonWriter writer;
+    for (size_t i = 0; i < count; ++i) {
+        writer.clear();
+        writer.startObject();
+        writer.key("id");
+        writer.uint64Value(i);
+        writer.key("text");
+        writer.string("line\n{\"nested\":[1,2]}\\");
+        writer.key("values");
+        writer.startArray();
+        for (size_t k = 0; k < i % 7; ++k) {
+            writer.doubleValue(static_cast<double>(i) / (k + 1));
+        }
+        writer.endArray();
+        writer.endObject();
+        messages.push_back(writer.toString());
+    }
+    return messages;
+}
+
+TEST(JsonWriterTest, RoundTripThroughFramers) {
+    std::vector<std::string> messages = writeMessages(300);
+    std::string stream;
+    for (const auto& m : messages) {
+        stream += m;
+        stream += '\n';
+    }
+
+    const JsonParserFactory::ParserType types[] = {
+        JsonParserFactory::ParserType::INCREMENTAL, JsonParserFactory::ParserType::RING_BUFFER
+    };
+    std::mt19937 rng(9);
+    for (auto type : types) {
+        std::vector<std::string> received;
+        auto parser = JsonParserFactory::createParser(type, [&](const std::string& json) {
+            received.push_back(json);
+        }, nullptr, 256);
+        size_t pos = 0;
+        while (pos < stream.size()) {
+            size_t n = std::min(stream.size() - pos, size_t(1 + rng() % 300));
+            parser->addData(stream.substr(pos, n));
+            pos += n;
+        }
+        EXPECT_EQ(messages, received);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
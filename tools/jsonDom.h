@@ -0,0 +1,561 @@
+#ifndef __JSON_DOM_H__
+#define __JSON_DOM_H__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include "jsonParser.h"
+#include "jsonNumber.h"
+
+/**
+ * @brief 基于块的顺序分配器（bump allocator）
+ *
+ * 分配只移动块内偏移，不单独释放；reset() 只把游标拨回第一块，
+ * 已申请的块全部保留复用，整棵文档树的释放是 O(1) 的。
+ */
+class JsonArena {
+    public:
+        explicit JsonArena(size_t block_size = 64 * 1024)
+            : _block_size(block_size < 256 ? 256 : block_size) {}
+
+        // 禁止拷贝
+        JsonArena(const JsonArena&) = delete;
+        JsonArena& operator=(const JsonArena&) = delete;
+
+        // 分配 size 字节，按 align 对齐（align 须为2的幂）
+        void* allocate(size_t size, size_t align = alignof(std::max_align_t)) {
+            while (_current < _blocks.size()) {
+                Block& block = _blocks[_current];
+                size_t offset = (_offset + align - 1) & ~(align - 1);
+                if (offset + size <= block.size) {
+                    _offset = offset + size;
+                    _used += size;
+                    return block.data.get() + offset;
+                }
+                ++_current;
+                _offset = 0;
+            }
+            // 现有块都放不下，申请新块；超大对象单独占一块
+            size_t block_size = size + align > _block_size ? size + align : _block_size;
+            Block block;
+            block.data.reset(new char[block_size]);
+            block.size = block_size;
+            _blocks.push_back(std::move(block));
+            _current = _blocks.size() - 1;
+            _offset = 0;
+            return allocate(size, align);
+        }
+
+        // 在 arena 中构造对象，对象的析构函数不会被调用
+        template<typename T, typename... Args>
+        T* create(Args&&... args) {
+            static_assert(std::is_trivially_destructible<T>::value, "JsonArena only holds trivially destructible types");
+            return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        // 复制一段字节到 arena
+        char* copy(const char* data, size_t size) {
+            char* p = static_cast<char*>(allocate(size ? size : 1, 1));
+            std::memcpy(p, data, size);
+            return p;
+        }
+
+        // 释放全部分配，保留已申请的块
+        void reset() {
+            _current = 0;
+            _offset = 0;
+            _used = 0;
+        }
+
+        // 已分配的字节数
+        size_t bytesUsed() const {
+            return _used;
+        }
+
+        // 已申请的块总字节数
+        size_t bytesReserved() const {
+            size_t total = 0;
+            for (const auto& block : _blocks) {
+                total += block.size;
+            }
+            return total;
+        }
+
+    private:
+        struct Block {
+            std::unique_ptr<char[]> data;
+            size_t size = 0;
+        };
+
+        std::vector<Block> _blocks;
+        size_t _block_size;
+        size_t _current = 0;     // 当前分配所在的块
+        size_t _offset = 0;      // 当前块内偏移
+        size_t _used = 0;
+};
+
+enum class JsonType : uint8_t {
+    Null,
+    Bool,
+    Int64,      // 整数，可用 int64_t 表示
+    UInt64,     // 超出 int64_t 的正整数
+    Double,     // 浮点数
+    String,
+    Array,
+    Object
+};
+
+/**
+ * @brief DOM 节点
+ *
+ * 字符串和键保存为源缓冲区中的视图，不复制；含转义的字符串在访问时才反转义。
+ * 数字在解析时由 JsonNumberParser 转换，整数与浮点数分开保存，同时保留原始文本。
+ * 数组和对象的子节点按顺序串成单链表，对象成员的键保存在子节点上。
+ * 节点在 JsonArena 中分配，生命周期跟随所属的 JsonDocument。
+ */
+class JsonValue {
+    public:
+        // 子节点迭代器
+        class Iterator {
+            public:
+                explicit Iterator(const JsonValue* node) : _node(node) {}
+                const JsonValue& operator*() const { return *_node; }
+                const JsonValue* operator->() const { return _node; }
+                Iterator& operator++() { _node = _node->_next; return *this; }
+                bool operator!=(const Iterator& other) const { return _node != other._node; }
+                bool operator==(const Iterator& other) const { return _node == other._node; }
+            private:
+                const JsonValue* _node;
+        };
+
+        JsonValue() {}
+
+        JsonType type() const { return _type; }
+        bool isNull() const { return _type == JsonType::Null; }
+        bool isBool() const { return _type == JsonType::Bool; }
+        bool isNumber() const { return isInteger() || _type == JsonType::Double; }
+        bool isInteger() const { return _type == JsonType::Int64 || _type == JsonType::UInt64; }
+        bool isDouble() const { return _type == JsonType::Double; }
+        bool isString() const { return _type == JsonType::String; }
+        bool isArray() const { return _type == JsonType::Array; }
+        bool isObject() const { return _type == JsonType::Object; }
+
+        bool asBool() const { return _type == JsonType::Bool && _bool; }
+
+        // 数字的原始文本
+        JsonView rawNumber() const {
+            return isNumber() ? _text : JsonView();
+        }
+
+        // 数值，非数字返回 0
+        double asDouble() const {
+            return isNumber() ? _number.toDouble() : 0.0;
+        }
+
+        int64_t asInt64() const {
+            return isNumber() ? _number.toInt64() : 0;
+        }
+
+        uint64_t asUInt64() const {
+            if (!isNumber()) return 0;
+            return _number.type == JsonNumberType::Double ? static_cast<uint64_t>(_number.d) : _number.u;
+        }
+
+        // 字符串引号内的原始字节（未反转义）
+        JsonView rawString() const {
+            return _type == JsonType::String ? _text : JsonView();
+        }
+
+        // 字符串是否包含转义序列
+        bool hasEscape() const {
+            return _escaped;
+        }
+
+        // 字符串内容：无转义时直接返回源缓冲区视图，否则反转义到 scratch 并返回其视图
+        JsonView stringView(std::string& scratch) const {
+            if (_type != JsonType::String) return JsonView();
+            return resolve(_text, _escaped, scratch);
+        }
+
+        // 字符串内容（拷贝）
+        std::string getString() const {
+            std::string scratch;
+            return stringView(scratch).toString();
+        }
+
+        // 对象成员的键（未反转义）
+        JsonView rawKey() const { return _key; }
+
+        // 对象成员的键
+        JsonView keyView(std::string& scratch) const {
+            return resolve(_key, _key_escaped, scratch);
+        }
+
+        std::string getKey() const {
+            std::string scratch;
+            return keyView(scratch).toString();
+        }
+
+        // 数组元素或对象成员个数
+        size_t size() const {
+            return (_type == JsonType::Array || _type == JsonType::Object) ? _count : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        Iterator begin() const { return Iterator(isContainer() ? _first : nullptr); }
+        Iterator end() const { return Iterator(nullptr); }
+
+        // 按下标访问数组元素（O(n)），越界返回 nullptr
+        const JsonValue* at(size_t index) const {
+            if (_type != JsonType::Array) return nullptr;
+            const JsonValue* node = _first;
+            while (node && index--) node = node->_next;
+            return node;
+        }
+
+        // 按键查找对象成员（O(n)），不存在返回 nullptr
+        const JsonValue* find(const char* key) const {
+            return find(key, std::strlen(key));
+        }
+
+        const JsonValue* find(const char* key, size_t len) const {
+            if (_type != JsonType::Object) return nullptr;
+            std::string scratch;
+            for (const JsonValue* node = _first; node; node = node->_next) {
+                JsonView k = node->_key_escaped ? node->keyView(scratch) : node->_key;
+                if (k.size == len && std::memcmp(k.data, key, len) == 0) {
+                    return node;
+                }
+            }
+            return nullptr;
+        }
+
+        const JsonValue* find(const std::string& key) const {
+            return find(key.data(), key.size());
+        }
+
+        // 下一个兄弟节点
+        const JsonValue* next() const { return _next; }
+
+    private:
+        friend class JsonDocument;
+
+        bool isContainer() const {
+            return _type == JsonType::Array || _type == JsonType::Object;
+        }
+
+        static JsonView resolve(JsonView raw, bool escaped, std::string& scratch) {
+            if (!escaped) return raw;
+            scratch.clear();
+            jsonUnescape(raw, scratch);
+            return JsonView(scratch.data(), scratch.size());
+        }
+
+        JsonType _type = JsonType::Null;
+        bool _bool = false;
+        bool _escaped = false;        // 字符串值含转义
+        bool _key_escaped = false;    // 键含转义
+        uint32_t _count = 0;          // 子节点个数
+        JsonView _key;                // 对象成员的键
+        JsonView _text;               // 字符串/数字的原始文本
+        JsonNumber _number;           // 数字的值
+        JsonValue* _first = nullptr;  // 第一个子节点
+        JsonValue* _last = nullptr;   // 最后一个子节点（构建时追加用）
+        JsonValue* _next = nullptr;   // 下一个兄弟节点
+};
+
+/**
+ * @brief JSON 文档：把一段完整的 JSON 文本解析为 DOM 树
+ *
+ * 节点分配在内部的 JsonArena 中，每个节点没有单独的 malloc；
+ * 字符串和数字引用源缓冲区，源缓冲区须在文档使用期间保持有效。
+ * 重新 parse() 或 clear() 时整棵树一次性释放，arena 的块留作下次复用。
+ *
+ * 与分帧器配合：
+ *   JsonDocument doc;
+ *   auto parser = JsonParserFactory::createViewParser(type, [&](const JsonFrame& frame) {
+ *       if (doc.parse(frame)) handle(*doc.root());
+ *   });
+ */
+class JsonDocument {
+    public:
+        explicit JsonDocument(size_t arena_block_size = 64 * 1024, size_t max_depth = 512)
+            : _arena(arena_block_size), _max_depth(max_depth) {}
+
+        // 禁止拷贝
+        JsonDocument(const JsonDocument&) = delete;
+        JsonDocument& operator=(const JsonDocument&) = delete;
+
+        // 解析 [data, data+len)，成功返回 true；失败时 error()/errorOffset() 给出原因和位置
+        bool parse(const char* data, size_t len) {
+            _arena.reset();
+            return parseKeepArena(data, len);
+        }
+
+        bool parse(const JsonView& view) {
+            return parse(view.data, view.size);
+        }
+
+        // 解析分帧器交付的一帧；帧在环形缓冲区中回绕时先拼接到 arena 中
+        // 连续帧不复制，文档只在回调期间有效
+        bool parse(const JsonFrame& frame) {
+            if (frame.contiguous()) {
+                return parse(frame.first.data, frame.first.size);
+            }
+            _arena.reset();
+            char* joined = static_cast<char*>(_arena.allocate(frame.size() ? frame.size() : 1, 1));
+            frame.copyTo(joined);
+            return parseKeepArena(joined, frame.size());
+        }
+
+        // 根节点，解析失败时为 nullptr
+        const JsonValue* root() const {
+            return _root;
+        }
+
+        const std::string& error() const {
+            return _error;
+        }
+
+        size_t errorOffset() const {
+            return _error_offset;
+        }
+
+        // 释放整棵树，O(1)
+        void clear() {
+            _arena.reset();
+            _root = nullptr;
+            _error.clear();
+            _error_offset = 0;
+        }
+
+        // 当前文档占用的 arena 字节数
+        size_t memoryUsed() const {
+            return _arena.bytesUsed();
+        }
+
+    private:
+        bool parseKeepArena(const char* data, size_t len) {
+            _root = nullptr;
+            _error.clear();
+            _error_offset = 0;
+            _begin = data;
+            _p = data;
+            _end = data + len;
+            skipWhitespace();
+            _root = parseValue(0);
+            if (_root) {
+                skipWhitespace();
+                if (_p != _end) {
+                    _root = nullptr;
+                    fail("JSON之后存在多余字符");
+                }
+            }
+            return _root != nullptr;
+        }
+
+        JsonValue* fail(const char* message) {
+            if (_error.empty()) {
+                _error = message;
+                _error_offset = static_cast<size_t>(_p - _begin);
+            }
+            return nullptr;
+        }
+
+        void skipWhitespace() {
+            while (_p < _end && (*_p == ' ' || *_p == '\n' || *_p == '\r' || *_p == '\t')) {
+                ++_p;
+            }
+        }
+
+        JsonValue* newValue(JsonType type) {
+            JsonValue* v = _arena.create<JsonValue>();
+            v->_type = type;
+            return v;
+        }
+
+        static void appendChild(JsonValue* parent, JsonValue* child) {
+            if (parent->_last) {
+                parent->_last->_next = child;
+            } else {
+                parent->_first = child;
+            }
+            parent->_last = child;
+            ++parent->_count;
+        }
+
+        JsonValue* parseValue(size_t depth) {
+            if (_p >= _end) return fail("JSON不完整");
+            switch (*_p) {
+                case '{': return parseObject(depth);
+                case '[': return parseArray(depth);
+                case '"': {
+                    JsonValue* v = newValue(JsonType::String);
+                    if (!parseString(v->_text, v->_escaped)) return nullptr;
+                    return v;
+                }
+                case 't': return parseLiteral("true", JsonType::Bool, true);
+                case 'f': return parseLiteral("false", JsonType::Bool, false);
+                case 'n': return parseLiteral("null", JsonType::Null, false);
+                default: return parseNumber();
+            }
+        }
+
+        JsonValue* parseLiteral(const char* word, JsonType type, bool value) {
+            size_t len = std::strlen(word);
+            if (static_cast<size_t>(_end - _p) < len || std::memcmp(_p, word, len) != 0) {
+                return fail("无效的字面量");
+            }
+            _p += len;
+            JsonValue* v = newValue(type);
+            v->_bool = value;
+            return v;
+        }
+
+        JsonValue* parseNumber() {
+            const char* start = _p;
+            if (*_p != '-' && (*_p < '0' || *_p > '9')) return fail("无效的值");
+            while (_p < _end && ((*_p >= '0' && *_p <= '9') || *_p == '-' || *_p == '+' ||
+                                 *_p == '.' || *_p == 'e' || *_p == 'E')) {
+                ++_p;
+            }
+            JsonNumber number;
+            if (!JsonNumberParser::parse(start, _p - start, number)) {
+                _p = start;
+                return fail("无效的数字");
+            }
+            JsonValue* v = newValue(number.type == JsonNumberType::Int64 ? JsonType::Int64
+                                  : number.type == JsonNumberType::UInt64 ? JsonType::UInt64
+                                  : JsonType::Double);
+            v->_text = JsonView(start, _p - start);
+            v->_number = number;
+            return v;
+        }
+
+        static bool isHex(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+
+        // 解析字符串，out 为引号内的原始字节，escaped 表示是否含转义
+        bool parseString(JsonView& out, bool& escaped) {
+            ++_p; // 跳过起始引号
+            const char* start = _p;
+            escaped = false;
+            while (_p < _end) {
+                unsigned char c = static_cast<unsigned char>(*_p);
+                if (c == '"') {
+                    out = JsonView(start, _p - start);
+                    ++_p;
+                    return true;
+                }
+                if (c == '\\') {
+                    escaped = true;
+                    if (_p + 1 >= _end) break;
+                    char e = _p[1];
+                    if (e == 'u') {
+                        if (_end - _p < 6 || !isHex(_p[2]) || !isHex(_p[3]) || !isHex(_p[4]) || !isHex(_p[5])) {
+                            fail("无效的\\u转义");
+                            return false;
+                        }
+                        _p += 6;
+                        continue;
+                    }
+                    if (e != '"' && e != '\\' && e != '/' && e != 'b' && e != 'f' && e != 'n' && e != 'r' && e != 't') {
+                        fail("无效的转义字符");
+                        return false;
+                    }
+                    _p += 2;
+                    continue;
+                }
+                if (c < 0x20) {
+                    fail("字符串中含未转义的控制字符");
+                    return false;
+                }
+                ++_p;
+            }
+            fail("字符串未结束");
+            return false;
+        }
+
+        JsonValue* parseArray(size_t depth) {
+            if (depth >= _max_depth) return fail("嵌套层数超出限制");
+            ++_p;
+            JsonValue* arr = newValue(JsonType::Array);
+            skipWhitespace();
+            if (_p < _end && *_p == ']') {
+                ++_p;
+                return arr;
+            }
+            while (true) {
+                skipWhitespace();
+                JsonValue* item = parseValue(depth + 1);
+                if (!item) return nullptr;
+                appendChild(arr, item);
+                skipWhitespace();
+                if (_p >= _end) return fail("数组未结束");
+                if (*_p == ',') {
+                    ++_p;
+                } else if (*_p == ']') {
+                    ++_p;
+                    return arr;
+                } else {
+                    return fail("数组中缺少','或']'");
+                }
+            }
+        }
+
+        JsonValue* parseObject(size_t depth) {
+            if (depth >= _max_depth) return fail("嵌套层数超出限制");
+            ++_p;
+            JsonValue* obj = newValue(JsonType::Object);
+            skipWhitespace();
+            if (_p < _end && *_p == '}') {
+                ++_p;
+                return obj;
+            }
+            while (true) {
+                skipWhitespace();
+                if (_p >= _end || *_p != '"') return fail("对象的键必须是字符串");
+                JsonView key;
+                bool key_escaped = false;
+                if (!parseString(key, key_escaped)) return nullptr;
+                skipWhitespace();
+                if (_p >= _end || *_p != ':') return fail("对象中缺少':'");
+                ++_p;
+                skipWhitespace();
+                JsonValue* member = parseValue(depth + 1);
+                if (!member) return nullptr;
+                member->_key = key;
+                member->_key_escaped = key_escaped;
+                appendChild(obj, member);
+                skipWhitespace();
+                if (_p >= _end) return fail("对象未结束");
+                if (*_p == ',') {
+                    ++_p;
+                } else if (*_p == '}') {
+                    ++_p;
+                    return obj;
+                } else {
+                    return fail("对象中缺少','或'}'");
+                }
+            }
+        }
+
+        JsonArena _arena;
+        size_t _max_depth;
+        JsonValue* _root = nullptr;
+        std::string _error;
+        size_t _error_offset = 0;
+        const char* _begin = nullptr;
+        const char* _p = nullptr;
+        const char* _end = nullptr;
+};
+
+#endif // __JSON_DOM_H__
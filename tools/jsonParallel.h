@@ -0,0 +1,330 @@
+#ifndef __JSON_PARALLEL_H__
+#define __JSON_PARALLEL_H__
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include "jsonParser.h"
+#include "jsonScanner.h"
+
+// 并行分帧的结果
+struct JsonParallelResult {
+    size_t messages = 0;     // 交付的完整消息数
+    size_t consumed = 0;     // 最后一条完整消息之后的偏移，[consumed, len) 留给下一批数据
+    bool complete = true;    // 数据末尾没有未结束的消息（或字符串）
+};
+
+/**
+ * @brief 多线程 JSON 分帧器
+ *
+ * 把一大块连续数据（内存或 mmap 的文件）均分给 N 个线程，分三步：
+ * 1. 推测：每段独立扫描，求出未转义引号的奇偶性，并在“段首在字符串外/内”两种假设下
+ *    分别求括号深度的净变化（两种假设下字符串区间互为取反，一次扫描得到）；
+ * 2. 校正：按段顺序累积，得到每段段首的真实字符串状态和括号深度；
+ * 3. 分帧：每段从已知状态出发扫描，交付起始括号位于本段的消息，跨段的消息由起始段读完。
+ * 段首是否被反斜杠转义由向前数连续反斜杠确定。
+ *
+ * 三个阶段在同一组线程上执行，阶段之间以屏障同步，校正和编号由最后到达屏障的线程完成。
+ *
+ * 有序交付时回调在调用线程中按消息顺序执行；无序交付时回调在各工作线程中并发执行，
+ * seq 为消息在整块数据中的全局序号，调用方可据此重排。
+ * 假定输入由合法的 JSON 消息组成，消息之间只有空白或换行；多余的结束括号、
+ * 消息之外未结束的字符串通过 ErrorCallback 报告。末尾未结束的消息由 complete 标出，
+ * 留给下一批数据；parseFile() 读到文件末尾时仍未结束则报错。
+ */
+class JsonParallelFramer {
+    public:
+        using FrameCallback = std::function<void(const JsonView& json, uint64_t seq)>;
+        using ErrorCallback = JsonParserBase::ErrorCallback;
+
+        enum class Delivery {
+            Ordered,
+            Unordered
+        };
+
+        // threads 为 0 时取硬件线程数；每段至少 min_segment 字节，数据较小时少开线程
+        explicit JsonParallelFramer(FrameCallback callback, ErrorCallback error_callback = nullptr,
+                                    size_t threads = 0, size_t min_segment = 1 << 20)
+            : _callback(std::move(callback)),
+              _error_callback(std::move(error_callback)),
+              _threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+              _min_segment(std::max<size_t>(min_segment, JsonStructuralScanner::BLOCK_SIZE)) {}
+
+        JsonParallelResult frame(const char* data, size_t len, Delivery delivery = Delivery::Ordered) {
+            JsonParallelResult result;
+            if (len == 0) return result;
+
+            // 切段，段边界对齐到64字节
+            size_t count = std::min(_threads, std::max<size_t>(1, len / _min_segment));
+            size_t step = (len / count + JsonStructuralScanner::BLOCK_SIZE - 1) /
+                          JsonStructuralScanner::BLOCK_SIZE * JsonStructuralScanner::BLOCK_SIZE;
+            std::vector<Segment> segments;
+            for (size_t begin = 0; begin < len; begin += step) {
+                Segment seg;
+                seg.begin = begin;
+                seg.end = std::min(len, begin + step);
+                segments.push_back(seg);
+            }
+
+            std::vector<uint64_t> first_seq(segments.size());
+            auto correct = [&]() {
+                // 2. 校正
+                bool in_string = false;
+                int64_t depth = 0;
+                bool unbalanced = false;
+                for (auto& seg : segments) {
+                    seg.start_in_string = in_string;
+                    seg.start_depth = depth;
+                    depth += in_string ? seg.delta_if_string : seg.delta_if_outside;
+                    if (depth < 0) {
+                        unbalanced = true;
+                        depth = 0;
+                    }
+                    in_string ^= seg.quote_parity;
+                }
+                if (unbalanced) {
+                    reportError("括号不匹配: 多余的结束括号");
+                }
+                if (in_string && depth == 0) {
+                    reportError("消息之外的字符串未结束");
+                }
+                result.complete = !in_string && depth == 0;
+            };
+            auto number = [&]() {
+                for (size_t i = 0; i < segments.size(); ++i) {
+                    first_seq[i] = result.messages;
+                    result.messages += segments[i].frames.size();
+                    if (!segments[i].frames.empty()) {
+                        result.consumed = segments[i].frames.back().second;
+                    }
+                }
+            };
+
+            // 1. 推测 -> 2. 校正 -> 3. 分帧 -> 编号 -> (无序)交付
+            PhaseBarrier barrier(segments.size());
+            runParallel(segments.size(), [&](size_t i) {
+                speculate(data, segments[i]);
+                barrier.arriveAndWait(correct);
+                frameSegment(data, len, segments[i]);
+                barrier.arriveAndWait(number);
+                if (delivery == Delivery::Unordered) {
+                    deliver(data, segments[i], first_seq[i]);
+                }
+            });
+
+            if (delivery == Delivery::Ordered) {
+                for (size_t i = 0; i < segments.size(); ++i) {
+                    deliver(data, segments[i], first_seq[i]);
+                }
+            }
+            return result;
+        }
+
+        JsonParallelResult frame(const std::string& data, Delivery delivery = Delivery::Ordered) {
+            return frame(data.data(), data.size(), delivery);
+        }
+
+        // 映射整个文件并行分帧，打开失败返回 false 并调用 ErrorCallback
+        bool parseFile(const std::string& path, Delivery delivery = Delivery::Ordered, JsonParallelResult* result = nullptr) {
+            JsonMappedFile file;
+            if (!file.open(path)) {
+                reportError("无法打开文件: " + path);
+                return false;
+            }
+            file.willNeed(0, file.size());
+            JsonParallelResult r = frame(file.data(), file.size(), delivery);
+            if (!r.complete) {
+                reportError("输入结束时消息不完整");
+            }
+            if (result) *result = r;
+            return true;
+        }
+
+        size_t threads() const {
+            return _threads;
+        }
+
+    private:
+        struct Segment {
+            size_t begin = 0;
+            size_t end = 0;
+            // 推测阶段的结果
+            bool quote_parity = false;          // 段内未转义引号个数的奇偶
+            int64_t delta_if_outside = 0;       // 段首在字符串外时的深度变化
+            int64_t delta_if_string = 0;        // 段首在字符串内时的深度变化
+            // 校正后的段首状态
+            bool start_in_string = false;
+            int64_t start_depth = 0;
+            // 起始括号在本段的消息 [first, second)
+            std::vector<std::pair<size_t, size_t>> frames;
+        };
+
+        // 可重复使用的屏障：最后到达的线程执行 completion，之后放行本轮所有线程
+        class PhaseBarrier {
+            public:
+                explicit PhaseBarrier(size_t count) : _count(count) {}
+
+                template<typename Fn>
+                void arriveAndWait(Fn& completion) {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    const uint64_t generation = _generation;
+                    if (++_arrived < _count) {
+                        _cv.wait(lock, [&]() { return _generation != generation; });
+                        return;
+                    }
+                    completion();
+                    _arrived = 0;
+                    ++_generation;
+                    _cv.notify_all();
+                }
+
+            private:
+                std::mutex _mutex;
+                std::condition_variable _cv;
+                size_t _count;
+                size_t _arrived = 0;
+                uint64_t _generation = 0;
+        };
+
+        // 在 n 个线程（含调用线程）上各执行一次 fn(i)
+        template<typename Fn>
+        void runParallel(size_t n, Fn fn) {
+            if (n == 1) {
+                fn(0);
+                return;
+            }
+            std::vector<std::thread> workers;
+            workers.reserve(n - 1);
+            for (size_t i = 1; i < n; ++i) {
+                workers.emplace_back(fn, i);
+            }
+            fn(0);
+            for (auto& t : workers) {
+                t.join();
+            }
+        }
+
+        // 段首字符是否被前面的反斜杠转义：向前数连续反斜杠的个数
+        static uint64_t escapeCarryAt(const char* data, size_t pos) {
+            size_t n = 0;
+            while (pos > n && data[pos - n - 1] == '\\') ++n;
+            return n & 1;
+        }
+
+        // 求一个块的掩码和字符串区间，n ≤ 64
+        static uint64_t classify(const char* p, size_t n, JsonBlockMasks& masks,
+                                 uint64_t& escaped_carry, uint64_t& in_string_carry) {
+            if (n == JsonStructuralScanner::BLOCK_SIZE) {
+                JsonStructuralScanner::scanBlock(p, masks);
+            } else {
+                JsonStructuralScanner::scanTail(p, n, masks);
+            }
+            uint64_t escaped = JsonStructuralScanner::findEscaped(masks.backslash, escaped_carry);
+            if (n < JsonStructuralScanner::BLOCK_SIZE) {
+                escaped_carry = (escaped >> n) & 1;
+            }
+            uint64_t quotes = masks.quote & ~escaped;
+            uint64_t in_string = JsonStructuralScanner::prefixXor(quotes) ^ in_string_carry;
+            in_string_carry = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+            return in_string;
+        }
+
+        static int popcount(uint64_t x) {
+#if defined(_MSC_VER)
+            return static_cast<int>(__popcnt64(x));
+#else
+            return __builtin_popcountll(x);
+#endif
+        }
+
+        // 假设段首在字符串外扫描整段；段首在字符串内时字符串区间恰好取反
+        static void speculate(const char* data, Segment& seg) {
+            JsonBlockMasks masks;
+            uint64_t escaped_carry = escapeCarryAt(data, seg.begin);
+            uint64_t in_string_carry = 0;
+            int64_t outside = 0;
+            int64_t inside = 0;
+            for (size_t pos = seg.begin; pos < seg.end; pos += JsonStructuralScanner::BLOCK_SIZE) {
+                size_t n = std::min<size_t>(JsonStructuralScanner::BLOCK_SIZE, seg.end - pos);
+                uint64_t in_string = classify(data + pos, n, masks, escaped_carry, in_string_carry);
+                outside += popcount(masks.open & ~in_string) - popcount(masks.close & ~in_string);
+                inside += popcount(masks.open & in_string) - popcount(masks.close & in_string);
+            }
+            seg.quote_parity = in_string_carry != 0;
+            seg.delta_if_outside = outside;
+            seg.delta_if_string = inside;
+        }
+
+        // 从校正后的状态出发分帧；本段开始的最后一条消息跨段时继续读到它结束
+        static void frameSegment(const char* data, size_t len, Segment& seg) {
+            JsonBlockMasks masks;
+            uint64_t escaped_carry = escapeCarryAt(data, seg.begin);
+            uint64_t in_string_carry = seg.start_in_string ? ~uint64_t(0) : 0;
+            int64_t depth = seg.start_depth;
+            size_t start = 0;
+            bool started_here = false;
+
+            for (size_t pos = seg.begin; pos < len; pos += JsonStructuralScanner::BLOCK_SIZE) {
+                // 越过段尾后只需读完本段开始的消息；段首所在的消息由它的起始段读完
+                if (pos >= seg.end && !started_here) break;
+                size_t n = std::min<size_t>(JsonStructuralScanner::BLOCK_SIZE, len - pos);
+                uint64_t in_string = classify(data + pos, n, masks, escaped_carry, in_string_carry);
+                uint64_t structural = (masks.open | masks.close) & ~in_string;
+                while (structural) {
+                    const int bit = JsonStructuralScanner::trailingZeros(structural);
+                    const size_t idx = pos + bit;
+                    if (masks.open & (uint64_t(1) << bit)) {
+                        if (depth == 0) {
+                            if (idx >= seg.end) return;   // 下一段的消息
+                            start = idx;
+                            started_here = true;
+                        }
+                        ++depth;
+                    } else if (depth > 0) {
+                        --depth;
+                        if (depth == 0) {
+                            if (started_here) {
+                                seg.frames.push_back(std::make_pair(start, idx + 1));
+                            }
+                            started_here = false;
+                            if (idx >= seg.end) return;
+                        }
+                    }
+                    structural &= structural - 1;
+                }
+            }
+        }
+
+        void deliver(const char* data, const Segment& seg, uint64_t first_seq) {
+            uint64_t seq = first_seq;
+            for (const auto& f : seg.frames) {
+                try {
+                    _callback(JsonView(data + f.first, f.second - f.first), seq++);
+                } catch (const std::exception& e) {
+                    reportError(e.what());
+                }
+            }
+        }
+
+        void reportError(const std::string& message) {
+            std::lock_guard<std::mutex> lock(_error_mutex);
+            if (_error_callback) {
+                _error_callback(message);
+            } else {
+                std::cerr << "JSON解析错误: " << message << std::endl;
+            }
+        }
+
+        FrameCallback _callback;
+        ErrorCallback _error_callback;
+        size_t _threads;
+        size_t _min_segment;
+        std::mutex _error_mutex;    // 无序交付时错误回调可能来自多个线程
+};
+
+#endif // __JSON_PARALLEL_H__
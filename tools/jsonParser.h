@@ -7,8 +7,24 @@
 #include <iostream>
 #include <memory>
 #include <algorithm>
+#include <deque>
+#include <cstring>
+#include <stdexcept>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
 #include "memory_ptr.h"
 #include "memory/memoryPool.hpp"
+#include "jsonScanner.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define JSON_PARSER_HAS_MMAP 1
+#else
+#include <fstream>
+#endif
 // #include <nlohmann/json.hpp>
 
 
@@ -21,6 +37,10 @@ class JsonStateTtacker{
         bool _in_string = false;     // 是否在字符串内
         bool _escaped = false;       // 是否是转义字符
         bool _json_started = false;  // 是否已开始JSON
+        size_t _consumed = 0;        // 自上次 reset 以来处理的字节数
+        size_t _start_offset = 0;    // JSON起始括号相对上次 reset 的偏移
+        int _max_depth = 0;          // 最大嵌套深度，0 表示不限制
+        bool _depth_exceeded = false; // 嵌套深度是否超限
     public:
         void reset() {
             _brace_count = 0;
@@ -28,61 +48,125 @@ class JsonStateTtacker{
             _in_string = false;
             _escaped = false;
             _json_started = false;
+            _consumed = 0;
+            _start_offset = 0;
+            _depth_exceeded = false;
         }
 
+    // 设置最大嵌套深度（大括号与中括号合计），0 表示不限制；reset() 不清除该设置
+    // 超限时 scan() 在超限的括号之后返回，depthExceeded() 为真，需 reset() 后才能继续
+    void setMaxDepth(int depth) {
+        _max_depth = depth;
+    }
+
     // 处理单个字符，返回是否找到完整的JSON
-    
-        // bool processChar(char c) {
-        //     // Handle escape sequences in strings
-        //     if (_escaped) {
-        //         _escaped = false;
-        //         return false;
-        //     }
-            
-        //     if (c == '\\' && _in_string) {
-        //         _escaped = true;
-        //         return false;
-        //     }
-            
-        //     // Handle string delimiters
-        //     if (c == '"' && !_escaped) {
-        //         _in_string = !_in_string;
-        //         return false;
-        //     }
-            
-        //     // Skip processing structure characters if inside a string
-        //     if (_in_string) {
-        //         return false;
-        //     }
-            
-        //     // Handle JSON structure characters
-        //     if (c == '{') {
-        //         _json_started = true;
-        //         _brace_count++;
-        //     } else if (c == '}') {
-        //         if (_brace_count > 0) {
-        //             _brace_count--;
-        //             // Only complete if all braces and brackets are balanced
-        //             if (_json_started && _brace_count == 0 && _bracket_count == 0) {
-        //                 return true; // 找到完整的JSON
-        //             }
-        //         }
-        //     } else if (c == '[') {
-        //         _bracket_count++;
-        //     } else if (c == ']') {
-        //         if (_bracket_count > 0) {
-        //             _bracket_count--;
-        //         }
-        //     }
-            
-        //     return false;
-        // }
-        
-    
+    // 字符串内的括号不计入结构，字符串内的反斜杠转义下一个字符
         bool processChar(char c) {
-            // 处理转义字符的代码保持不变...
-        
-            // 处理JSON结构字符
+            ++_consumed;
+            if (_in_string) {
+                if (_escaped) {
+                    _escaped = false;
+                } else if (c == '\\') {
+                    _escaped = true;
+                } else if (c == '"') {
+                    _in_string = false;
+                }
+                return false;
+            }
+            if (c == '"') {
+                _in_string = true;
+                return false;
+            }
+            return processStructural(c, _consumed - 1);
+        }
+
+    // 批量处理一段数据，返回消费的字节数：
+    // 找到完整JSON时为其结束位置+1（此时 isComplete() 为真），否则为 len
+    // 每64字节由位图并行求出被转义的字符和字符串区间（引号位图的前缀异或），
+    // 只对字符串外的括号调用 processStructural，跨块状态由 _in_string/_escaped 携带
+    size_t scan(const char* data, size_t len) {
+        JsonBlockMasks masks;
+        size_t pos = 0;
+        uint64_t escaped_carry = _escaped ? 1 : 0;
+        uint64_t in_string_carry = _in_string ? ~uint64_t(0) : 0;
+        while (pos < len) {
+            size_t n = len - pos;
+            if (n >= JsonStructuralScanner::BLOCK_SIZE) {
+                JsonStructuralScanner::scanBlock(data + pos, masks);
+                n = JsonStructuralScanner::BLOCK_SIZE;
+            } else {
+                JsonStructuralScanner::scanTail(data + pos, n, masks);
+            }
+
+            uint64_t escaped = JsonStructuralScanner::findEscaped(masks.backslash, escaped_carry);
+            if (n < JsonStructuralScanner::BLOCK_SIZE) {
+                // 尾块以空白填充，转义进位取实际末尾之后那一位
+                escaped_carry = (escaped >> n) & 1;
+            }
+            uint64_t quotes = masks.quote & ~escaped;
+            uint64_t in_string = JsonStructuralScanner::prefixXor(quotes) ^ in_string_carry;
+            in_string_carry = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+            uint64_t structural = (masks.open | masks.close) & ~in_string;
+            while (structural) {
+                size_t idx = pos + JsonStructuralScanner::trailingZeros(structural);
+                if (processStructural(data[idx], _consumed + idx)) {
+                    // 完整JSON结束于字符串外，后续字符从干净状态开始
+                    _in_string = false;
+                    _escaped = false;
+                    _consumed += idx + 1;
+                    return idx + 1;
+                }
+                structural &= structural - 1;
+            }
+            pos += n;
+        }
+        _in_string = in_string_carry != 0;
+        _escaped = escaped_carry != 0;
+        _consumed += len;
+        return len;
+    }
+
+    // 检查是否已开始JSON
+    bool isStarted() const {
+        return _json_started;
+    }
+
+    // 检查JSON是否完整
+    bool isComplete() const {
+        return _json_started && _brace_count == 0 && _bracket_count == 0;
+    }
+
+    // 是否处于字符串内
+    bool inString() const {
+        return _in_string;
+    }
+
+    // JSON起始括号相对上次 reset 的偏移，isStarted() 为真时有效
+    size_t startOffset() const {
+        return _start_offset;
+    }
+
+    // 自上次 reset 以来处理的字节数
+    size_t consumed() const {
+        return _consumed;
+    }
+
+    // 嵌套深度是否超过 setMaxDepth() 的限制
+    bool depthExceeded() const {
+        return _depth_exceeded;
+    }
+
+    private:
+        // 处理字符串外的结构字符，offset 为该字符相对上次 reset 的偏移
+        bool processStructural(char c, size_t offset) {
+            if (!_json_started && (c == '{' || c == '[')) {
+                _start_offset = offset;
+            }
+            if ((c == '{' || c == '[') && _max_depth > 0 && _brace_count + _bracket_count >= _max_depth) {
+                _depth_exceeded = true;
+                return true;
+            }
             if (c == '{') {
                 _json_started = true;  // 以大括号开始
                 _brace_count++;
@@ -95,35 +179,313 @@ class JsonStateTtacker{
                     }
                 }
             } else if (c == '[') {
-                _json_started = true;  // 添加：以中括号开始也设置JSON开始标志
+                _json_started = true;  // 以中括号开始也设置JSON开始标志
                 _bracket_count++;
             } else if (c == ']') {
                 if (_bracket_count > 0) {
                     _bracket_count--;
-                    // 添加：检查是否完成
                     if (_json_started && _brace_count == 0 && _bracket_count == 0) {
                         return true; // 找到完整的JSON
                     }
                 }
             }
-            
             return false;
         }
-    // 检查是否已开始JSON
-    bool isStarted() const {
-        return _json_started;
+};
+
+// 非拥有的字节区间
+struct JsonView {
+    const char* data = nullptr;
+    size_t size = 0;
+
+    JsonView() {}
+    JsonView(const char* d, size_t n) : data(d), size(n) {}
+
+    bool empty() const { return size == 0; }
+    const char* begin() const { return data; }
+    const char* end() const { return data + size; }
+    char operator[](size_t i) const { return data[i]; }
+    std::string toString() const { return std::string(data, size); }
+};
+
+// 一条完整JSON在解析器缓冲区中的位置，仅在回调期间有效
+// 环形缓冲区中的数据回绕时分为 first、second 两段，否则 second 为空
+struct JsonFrame {
+    JsonView first;
+    JsonView second;
+
+    JsonFrame() {}
+    explicit JsonFrame(JsonView view) : first(view) {}
+    JsonFrame(JsonView a, JsonView b) : first(a), second(b) {}
+
+    size_t size() const { return first.size + second.size; }
+    bool empty() const { return size() == 0; }
+    bool contiguous() const { return second.empty(); }
+
+    // 拷贝到 out，out 至少有 size() 字节
+    void copyTo(char* out) const {
+        std::memcpy(out, first.data, first.size);
+        if (second.size) std::memcpy(out + first.size, second.data, second.size);
     }
 
-    // 检查JSON是否完整
-    bool isComplete() const {
-        return _json_started && _brace_count == 0 && _bracket_count == 0;
+    std::string toString() const {
+        std::string s;
+        s.reserve(size());
+        s.append(first.data, first.size);
+        s.append(second.data, second.size);
+        return s;
+    }
+};
+
+// 去除字符串外的空白字符（压缩JSON），字符串内容保持不变，结果追加到 out
+inline void minifyJson(const JsonFrame& frame, std::string& out) {
+    out.reserve(out.size() + frame.size());
+    bool in_string = false;
+    bool escaped = false;
+    const JsonView parts[2] = {frame.first, frame.second};
+    for (int part = 0; part < 2; ++part) {
+        for (char c : parts[part]) {
+            if (in_string) {
+                if (escaped) {
+                    escaped = false;
+                } else if (c == '\\') {
+                    escaped = true;
+                } else if (c == '"') {
+                    in_string = false;
+                }
+            } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                continue;
+            } else if (c == '"') {
+                in_string = true;
+            }
+            out.push_back(c);
+        }
+    }
+}
+
+// 把 Unicode 码点按 UTF-8 编码追加到 out
+inline void jsonAppendUtf8(uint32_t cp, std::string& out) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+// 解析4位十六进制数，输入须已校验
+inline uint32_t jsonHex4(const char* p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = p[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else v |= c - 'A' + 10;
+    }
+    return v;
+}
+
+// JSON字符串反转义（不含引号），结果追加到 out；输入须已通过转义合法性校验
+inline void jsonUnescape(JsonView raw, std::string& out) {
+    const char* p = raw.data;
+    const char* end = raw.data + raw.size;
+    out.reserve(out.size() + raw.size);
+    while (p < end) {
+        const char* bs = static_cast<const char*>(std::memchr(p, '\\', end - p));
+        if (!bs) {
+            out.append(p, end - p);
+            break;
+        }
+        out.append(p, bs - p);
+        p = bs + 1;
+        char c = *p++;
+        switch (c) {
+            case 'b': out.push_back('\b'); break;
+            case 'f': out.push_back('\f'); break;
+            case 'n': out.push_back('\n'); break;
+            case 'r': out.push_back('\r'); break;
+            case 't': out.push_back('\t'); break;
+            case 'u': {
+                uint32_t cp = jsonHex4(p);
+                p += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                    uint32_t low = jsonHex4(p + 2);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        p += 6;
+                    }
+                }
+                jsonAppendUtf8(cp, out);
+                break;
+            }
+            default: out.push_back(c); break;   // '"'、'\\'、'/'
+        }
     }
+}
+
+// 只读映射整个文件；不支持 mmap 的平台退化为一次读入内存
+class JsonMappedFile {
+    public:
+        JsonMappedFile() {}
+
+        ~JsonMappedFile() {
+            close();
+        }
+
+        // 禁止拷贝
+        JsonMappedFile(const JsonMappedFile&) = delete;
+        JsonMappedFile& operator=(const JsonMappedFile&) = delete;
+
+        bool open(const std::string& path) {
+            close();
+#if defined(JSON_PARSER_HAS_MMAP)
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                ::close(fd);
+                return false;
+            }
+            _size = static_cast<size_t>(st.st_size);
+            if (_size > 0) {
+                void* addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr == MAP_FAILED) {
+                    ::close(fd);
+                    _size = 0;
+                    return false;
+                }
+                _data = static_cast<const char*>(addr);
+                // 顺序访问：内核加大预读，并尽早回收已读过的页
+                ::madvise(addr, _size, MADV_SEQUENTIAL);
+            }
+            ::close(fd);
+            return true;
+#else
+            std::ifstream in(path.c_str(), std::ios::binary);
+            if (!in) return false;
+            _fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            _data = _fallback.data();
+            _size = _fallback.size();
+            return true;
+#endif
+        }
+
+        void close() {
+#if defined(JSON_PARSER_HAS_MMAP)
+            if (_data) {
+                ::munmap(const_cast<char*>(_data), _size);
+            }
+#else
+            _fallback.clear();
+#endif
+            _data = nullptr;
+            _size = 0;
+        }
+
+        // 提示内核预读 [offset, offset+len)
+        void willNeed(size_t offset, size_t len) {
+#if defined(JSON_PARSER_HAS_MMAP)
+            advise(offset, len, MADV_WILLNEED);
+#else
+            (void)offset;
+            (void)len;
+#endif
+        }
+
+        // 提示内核 [0, offset) 不再需要，可立即回收
+        void dontNeed(size_t offset) {
+#if defined(JSON_PARSER_HAS_MMAP)
+            advise(0, offset, MADV_DONTNEED);
+#else
+            (void)offset;
+#endif
+        }
+
+        const char* data() const { return _data; }
+        size_t size() const { return _size; }
+
+    private:
+#if defined(JSON_PARSER_HAS_MMAP)
+        // 按页对齐后调用 madvise
+        void advise(size_t offset, size_t len, int advice) {
+            if (!_data || offset >= _size) return;
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            size_t begin = offset / page * page;
+            size_t end = std::min(_size, offset + len);
+            if (advice == MADV_DONTNEED) {
+                end = end / page * page;   // 只回收完整的页
+            }
+            if (end > begin) {
+                ::madvise(const_cast<char*>(_data) + begin, end - begin, advice);
+            }
+        }
+#else
+        std::string _fallback;
+#endif
+        const char* _data = nullptr;
+        size_t _size = 0;
+};
+
+// 解析器统计快照
+struct JsonParserStats {
+    uint64_t bytes_in = 0;          // 输入的字节数
+    uint64_t messages = 0;          // 分帧出的完整消息数（不含因超限丢弃的）
+    uint64_t errors = 0;            // 报告的错误数，含回调抛出的异常
+    uint64_t buffer_resizes = 0;    // 缓冲区扩容次数（分段解析器为挂接分段的次数）
+    uint64_t bytes_copied = 0;      // 解析器内部拷贝的字节数：写入缓冲区、整理前移、拼接、压缩、构造 std::string
+    uint64_t peak_buffered = 0;     // 缓冲区中未消费字节数的峰值
+    uint64_t callback_ns = 0;       // 回调累计耗时，开启 setTiming() 后才统计
+    uint64_t framing_ns = 0;        // 分帧累计耗时（输入调用的总耗时减去其中的回调耗时），同上
+};
+
+// 单写者计数器：只有解析线程写入，其它线程可随时读取；
+// 写入用 relaxed 的读后写而非读改写原子操作，开销与普通变量相同
+class JsonParserCounter {
+    public:
+        void add(uint64_t n) {
+            _value.store(_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        void sub(uint64_t n) {
+            _value.store(_value.load(std::memory_order_relaxed) - n, std::memory_order_relaxed);
+        }
+
+        void max(uint64_t n) {
+            if (n > _value.load(std::memory_order_relaxed)) {
+                _value.store(n, std::memory_order_relaxed);
+            }
+        }
+
+        uint64_t get() const {
+            return _value.load(std::memory_order_relaxed);
+        }
+
+        void reset() {
+            _value.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint64_t> _value{0};
 };
 
 class JsonParserBase {
     public:
         using JsonCallback = std::function<void(const std::string&)>;
         using ErrorCallback = std::function<void(const std::string&)>;
+        // 零拷贝回调：直接拿到缓冲区中的JSON字节，仅在回调期间有效
+        using JsonViewCallback = std::function<void(const JsonFrame&)>;
+        // 批量回调：一次收到一批消息的视图，视图仅在回调期间有效
+        using JsonBatchCallback = std::function<void(const JsonFrame* frames, size_t count)>;
         
         JsonParserBase(JsonCallback json_callback, ErrorCallback error_callback = nullptr)
         : _json_callback(std::move(json_callback)),
@@ -131,16 +493,382 @@ class JsonParserBase {
 
         virtual ~JsonParserBase() = default;
 
-        virtual void addData(const std::string& data) = 0;
+        virtual void addData(const char* data, size_t len) = 0;
+
+        void addData(const std::string& data) {
+            addData(data.data(), data.size());
+        }
+
+        // 取得内部缓冲区尾部至少 n 字节的可写区域，写入后调用 commit() 提交实际写入的字节数
+        // 调用方（如 read(2)）直接写进分帧缓冲区，省去中间缓冲和 std::string 两次拷贝
+        // 返回的指针在下一次 prepare/commit/addData/clear 之前有效
+        virtual char* prepare(size_t n) = 0;
+
+        // 提交 prepare() 区域开头的 n 字节并分帧
+        virtual void commit(size_t n) = 0;
+
+#if defined(JSON_PARSER_HAS_MMAP)
+        // 从 fd 读取一次，最多 max_bytes 字节，内核直接写入分帧缓冲区
+        // 返回值同 read(2)：>0 为读到的字节数，0 为 EOF，-1 为出错（errno 有效，EINTR 已重试）
+        ssize_t readFrom(int fd, size_t max_bytes = READ_CHUNK) {
+            const size_t want = readSizeHint(max_bytes);
+            char* p = prepare(want);
+            ssize_t n;
+            do {
+                n = ::read(fd, p, want);
+            } while (n < 0 && errno == EINTR);
+            if (n > 0) {
+                commit(static_cast<size_t>(n));
+            }
+            return n;
+        }
+#endif
 
         // 清空内部缓冲区
         virtual void clear() = 0;
 
+        // 输入结束时调用：缓冲区中剩余的不完整消息报错后丢弃
+        // 按分隔符分帧的解析器先交付最后一条没有结尾分隔符的消息
+        virtual void finish() {
+            if (trackerState().isStarted()) {
+                reportError("输入结束时消息不完整");
+            }
+            clear();
+        }
+
+        // 单条消息的最大字节数，0 表示不限制
+        // 超限时通过 ErrorCallback 报错并丢弃该消息；消息尚未结束时不再等待它的结束括号，
+        // 而是跳到下一个换行后紧跟 '{' 或 '[' 的位置重新同步，缓冲区不会无限增长
+        void setMaxMessageSize(size_t bytes) {
+            _max_message_size = bytes;
+        }
+
+        size_t maxMessageSize() const {
+            return _max_message_size;
+        }
+
+        // 最大嵌套深度（大括号与中括号合计），0 表示不限制；超限时的处理同 setMaxMessageSize
+        void setMaxDepth(size_t depth) {
+            _max_depth = depth;
+            trackerState().setMaxDepth(static_cast<int>(depth));
+        }
+
+        size_t maxDepth() const {
+            return _max_depth;
+        }
+
+        // 统计快照，可在任意线程调用
+        JsonParserStats stats() const {
+            JsonParserStats st;
+            st.bytes_in = _counters.bytes_in.get();
+            st.messages = _counters.messages.get();
+            st.errors = _counters.errors.get();
+            st.buffer_resizes = _counters.buffer_resizes.get();
+            st.bytes_copied = _counters.bytes_copied.get();
+            st.peak_buffered = _counters.peak_buffered.get();
+            st.callback_ns = _counters.callback_ns.get();
+            st.framing_ns = _counters.framing_ns.get();
+            return st;
+        }
+
+        // 计数清零，需在解析线程中调用
+        void resetStats() {
+            _counters.bytes_in.reset();
+            _counters.messages.reset();
+            _counters.errors.reset();
+            _counters.buffer_resizes.reset();
+            _counters.bytes_copied.reset();
+            _counters.peak_buffered.reset();
+            _counters.callback_ns.reset();
+            _counters.framing_ns.reset();
+        }
+
+        // 开启后统计回调与分帧的耗时（默认关闭）；每次输入调用和每次回调各读两次时钟
+        void setTiming(bool timing) {
+            _timing = timing;
+        }
+
+        // 设置零拷贝回调，设置后优先于 JsonCallback，不再为每条JSON构造 std::string
+        void setViewCallback(JsonViewCallback view_callback) {
+            _view_callback = std::move(view_callback);
+        }
+
+        // 设置批量回调，设置后优先于其它回调
+        // 每次 addData()/commit() 结束时（parseFile 为每个预读窗口结束时）把期间分帧出的消息一次交付，
+        // 整批只有一次间接调用和一次异常处理；适合批量写库、入队的处理函数
+        void setBatchCallback(JsonBatchCallback batch_callback) {
+            _batch_callback = std::move(batch_callback);
+        }
+
+        // 解析整个文件：只读映射后直接在映射区上分帧，完整消息以映射区的视图交付，不拷贝
+        // 调用前缓冲区中有未完成的消息时，先只拷贝补全它的那一段；文件末尾不完整的消息
+        // 留在缓冲区中，等待后续 addData()。打开文件失败返回 false 并调用 ErrorCallback
+        virtual bool parseFile(const std::string& path) {
+            FramingTimer timer(*this);
+            JsonMappedFile file;
+            if (!file.open(path)) {
+                reportError("无法打开文件: " + path);
+                return false;
+            }
+            const char* data = file.data();
+            const size_t len = file.size();
+            size_t pos = 0;
+
+            const JsonStateTtacker& pending = trackerState();
+            if (pending.isStarted()) {
+                // 有上限时最多补全 上限+1 字节，超出部分交给 addData 判定超限
+                JsonStateTtacker probe = pending;
+                size_t probe_len = _max_message_size ? std::min(len, _max_message_size + 1) : len;
+                pos = probe.scan(data, probe_len);
+                addData(data, pos);
+            } else {
+                clear();
+            }
+
+            JsonStateTtacker tracker;
+            tracker.setMaxDepth(static_cast<int>(_max_depth));
+            const size_t mapped_begin = pos;
+            size_t frame_base = pos;     // 当前消息扫描起点
+            size_t next_hint = pos;      // 下一次预读提示的位置
+            while (pos < len) {
+                if (pos >= next_hint) {
+                    flushBatch();
+                    file.willNeed(pos + FILE_WINDOW, FILE_WINDOW);
+                    file.dontNeed(frame_base);
+                    next_hint = pos + FILE_WINDOW;
+                }
+                size_t window = std::min(len - pos, next_hint - pos);
+                if (_resyncing) {
+                    pos += resync(data + pos, window);
+                    frame_base = pos;
+                    continue;
+                }
+                size_t message_bytes = tracker.isStarted() ? pos - frame_base - tracker.startOffset() : 0;
+                pos += tracker.scan(data + pos, scanLimit(message_bytes, window));
+                if (tracker.depthExceeded()) {
+                    startResync(depthError());
+                    frame_base = pos;
+                    tracker.reset();
+                } else if (tracker.isComplete()) {
+                    size_t start = frame_base + tracker.startOffset();
+                    if (_max_message_size && pos - start > _max_message_size) {
+                        reportError(sizeError());
+                    } else {
+                        processFrame(JsonFrame(JsonView(data + start, pos - start)));
+                    }
+                    frame_base = pos;
+                    tracker.reset();
+                } else if (_max_message_size && tracker.isStarted() &&
+                           pos - frame_base - tracker.startOffset() > _max_message_size) {
+                    startResync(sizeError(), data[pos - 1] == '\n');
+                    frame_base = pos;
+                    tracker.reset();
+                }
+            }
+            flushBatch();
+            // 映射区上直接分帧的字节，末尾拷贝进缓冲区的部分由 addData 计入
+            size_t mapped_end = tracker.isStarted() ? frame_base + tracker.startOffset() : len;
+            _counters.bytes_in.add(mapped_end - mapped_begin);
+            if (tracker.isStarted()) {
+                addData(data + mapped_end, len - mapped_end);
+            }
+            return true;
+        }
+
+        // 开启后回调收到的JSON去除了字符串外的空白（默认关闭，按原样交付）
+        // 压缩需要一次拷贝，开启后视图回调拿到的是内部暂存区的视图
+        void setMinify(bool minify) {
+            _minify = minify;
+        }
+
     protected:
+        // 内部计数器，由各解析器在对应位置累加
+        struct Counters {
+            JsonParserCounter bytes_in;
+            JsonParserCounter messages;
+            JsonParserCounter errors;
+            JsonParserCounter buffer_resizes;
+            JsonParserCounter bytes_copied;
+            JsonParserCounter peak_buffered;
+            JsonParserCounter callback_ns;
+            JsonParserCounter framing_ns;
+        };
+
+        // 放在每个输入入口（addData/commit/parseFile/finish）开头，统计本次调用中除回调外的耗时；
+        // 入口之间互相调用时只在最外层计时
+        class FramingTimer {
+            public:
+                explicit FramingTimer(JsonParserBase& parser)
+                    : _parser(parser), _active(parser._timing_depth++ == 0 && parser._timing) {
+                    if (_active) {
+                        _start = nowNs();
+                        _callback_before = _parser._counters.callback_ns.get();
+                    }
+                }
+
+                ~FramingTimer() {
+                    --_parser._timing_depth;
+                    if (_active) {
+                        uint64_t elapsed = nowNs() - _start;
+                        uint64_t callbacks = _parser._counters.callback_ns.get() - _callback_before;
+                        _parser._counters.framing_ns.add(elapsed - std::min(elapsed, callbacks));
+                    }
+                }
+
+            private:
+                JsonParserBase& _parser;
+                bool _active;
+                uint64_t _start = 0;
+                uint64_t _callback_before = 0;
+        };
+
+        static uint64_t nowNs() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static const size_t FILE_WINDOW = 16 * 1024 * 1024;   // parseFile 每次预读的字节数
+        static const size_t READ_CHUNK = 64 * 1024;           // readFrom 默认每次读取的字节数
+
+        // 当前未完成消息的扫描状态
+        virtual const JsonStateTtacker& trackerState() const = 0;
+        virtual JsonStateTtacker& trackerState() = 0;
+
+        // 报错并进入重新同步状态，调用方负责丢弃当前消息
+        // 坏区域恰好结束在换行上时 line_start 为真，下一个 '{' 或 '[' 即为同步点
+        void startResync(const std::string& message, bool line_start = false) {
+            reportError(message);
+            _resyncing = true;
+            _resync_line_start = line_start;
+        }
+
+        // 有长度上限时单次扫描的字节数：最多读到恰好越过上限的那个字节，
+        // 超限在越界处即被发现，不会把同一批数据中后面的消息当作坏区域吞掉
+        // message_bytes 为当前消息已扫描的字节数（消息未开始时为 0）
+        size_t scanLimit(size_t message_bytes, size_t available) const {
+            if (!_max_message_size) return available;
+            return std::min(available, _max_message_size + 1 - std::min(message_bytes, _max_message_size));
+        }
+
+        // 重新同步：跳过坏区域，直到换行之后（允许空白）出现 '{' 或 '['
+        // 返回消耗的字节数；找到同步点时停在该括号上并退出重新同步状态，否则为 len
+        size_t resync(const char* data, size_t len) {
+            size_t i = 0;
+            while (i < len) {
+                if (!_resync_line_start) {
+                    const void* nl = std::memchr(data + i, '\n', len - i);
+                    if (!nl) return len;
+                    i = static_cast<const char*>(nl) - data + 1;
+                    _resync_line_start = true;
+                    continue;
+                }
+                char c = data[i];
+                if (c == '{' || c == '[') {
+                    _resyncing = false;
+                    _resync_line_start = false;
+                    return i;
+                }
+                if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+                    _resync_line_start = false;
+                }
+                ++i;
+            }
+            return len;
+        }
+
+        // 退出重新同步状态（clear() 时调用）
+        void resetResync() {
+            _resyncing = false;
+            _resync_line_start = false;
+        }
+
+        std::string sizeError() const {
+            return "消息超过最大长度 " + std::to_string(_max_message_size) + " 字节，已丢弃";
+        }
+
+        std::string depthError() const {
+            return "嵌套深度超过 " + std::to_string(_max_depth) + " 层，已丢弃";
+        }
+
+        // readFrom 单次读取的字节数，不超过 max_bytes；分段存储的解析器据此避免跨段写入
+        virtual size_t readSizeHint(size_t max_bytes) const {
+            return max_bytes;
+        }
+
+        void reportError(const std::string& message) {
+            _counters.errors.add(1);
+            if (_error_callback) {
+                _error_callback(message);
+            } else {
+                std::cerr << "JSON解析错误: " << message << std::endl;
+            }
+        }
+
+        // 处理缓冲区中的一条完整JSON
+        void processFrame(const JsonFrame& frame) {
+            if (frame.empty()) return;
+            _counters.messages.add(1);
+
+            if (_batch_callback) {
+                appendBatch(frame);
+                return;
+            }
+            if (_minify) {
+                _counters.bytes_copied.add(frame.size());
+                _minify_buffer.clear();
+                minifyJson(frame, _minify_buffer);
+                if (!_view_callback) {
+                    processJson(_minify_buffer);
+                    return;
+                }
+                deliverFrame(JsonFrame(JsonView(_minify_buffer.data(), _minify_buffer.size())));
+                return;
+            }
+            if (!_view_callback) {
+                _counters.bytes_copied.add(frame.size());
+                processJson(frame.toString());
+                return;
+            }
+            deliverFrame(frame);
+        }
+
+        // 交付攒下的一批消息；子类在视图失效（缓冲区移动、分段归还）之前以及每次输入结束时调用
+        void flushBatch() {
+            if (_batch.empty()) return;
+            for (const auto& slot : _batch_minified) {
+                _batch[slot.first].first.data = _batch_arena.data() + slot.second;
+            }
+            const uint64_t t0 = _timing ? nowNs() : 0;
+            try {
+                _batch_callback(_batch.data(), _batch.size());
+            } catch (const std::exception& e) {
+                reportError(e.what());
+            }
+            if (_timing) {
+                _counters.callback_ns.add(nowNs() - t0);
+            }
+            _batch.clear();
+            _batch_minified.clear();
+            _batch_arena.clear();
+        }
+
+        void deliverFrame(const JsonFrame& frame) {
+            const uint64_t t0 = _timing ? nowNs() : 0;
+            try {
+                _view_callback(frame);
+            } catch (const std::exception& e) {
+                reportError(e.what());
+            }
+            if (_timing) {
+                _counters.callback_ns.add(nowNs() - t0);
+            }
+        }
+
         // 处理完整的JSON
         void processJson(const std::string& json) {
             if (json.empty()) return;
             
+            const uint64_t t0 = _timing ? nowNs() : 0;
             try {
                 // 解析JSON
                 // nlohmann::json parsed_json = nlohmann::json::parse(json);
@@ -151,16 +879,44 @@ class JsonParserBase {
                 }
             } catch (const std::exception& e) {
                 // 调用错误回调
-                if (_error_callback) {
-                    _error_callback(e.what());
-                } else {
-                    std::cerr << "JSON解析错误: " << e.what() << std::endl;
-                }
+                reportError(e.what());
+            }
+            if (_timing) {
+                _counters.callback_ns.add(nowNs() - t0);
             }
         }
         
         JsonCallback _json_callback;
         ErrorCallback _error_callback;
+        JsonViewCallback _view_callback;
+        JsonBatchCallback _batch_callback;
+        bool _minify = false;          // 是否压缩空白
+        std::string _minify_buffer;    // 压缩暂存区，跨消息复用
+        size_t _max_message_size = 0;  // 单条消息上限，0 表示不限制
+        size_t _max_depth = 0;         // 最大嵌套深度，0 表示不限制
+        bool _resyncing = false;       // 正在跳过坏区域
+        bool _resync_line_start = false; // 重新同步时已越过换行，等待 '{' 或 '['
+        Counters _counters;            // 统计计数
+        bool _timing = false;          // 是否统计耗时
+        int _timing_depth = 0;         // 输入入口的嵌套层数
+
+    private:
+        // 加入当前批；压缩后的消息写入批内暂存区，交付时再取地址（暂存区可能扩容）
+        void appendBatch(const JsonFrame& frame) {
+            if (_minify) {
+                _counters.bytes_copied.add(frame.size());
+                size_t offset = _batch_arena.size();
+                minifyJson(frame, _batch_arena);
+                _batch_minified.push_back(std::make_pair(_batch.size(), offset));
+                _batch.push_back(JsonFrame(JsonView(nullptr, _batch_arena.size() - offset)));
+                return;
+            }
+            _batch.push_back(frame);
+        }
+
+        std::vector<JsonFrame> _batch;                          // 尚未交付的一批消息
+        std::vector<std::pair<size_t, size_t>> _batch_minified; // 压缩消息在批中的下标及其在暂存区中的偏移
+        std::string _batch_arena;                               // 批内压缩消息的暂存区
 };
 
 // 增量解析
@@ -172,501 +928,932 @@ class InCrementalJsonParser : public JsonParserBase {
             {}
 
 
-            void addData(const std::string& data) override {
-                _buffer.append(data);
-                
-                // Use while loop instead of for loop to have better control over index increments
-                size_t i = _last_pos;
-                while (i < _buffer.size()) {
-                    char c = _buffer[i];
-                    // std::cout << "当前字符: " << _buffer.substr(0, i+1) <<"1"<<std::endl;
-                    
-                    // 跳过前导空白字符直到找到一个JSON开始
-                    if (!_state_tracker.isStarted()) {
-                        if (isspace(c)) {
-                            i++;
-                            continue;
-                        }
+        using JsonParserBase::addData;
+
+        void addData(const char* data, size_t len) override {
+            if (len == 0) return;
+            FramingTimer timer(*this);
+            std::memcpy(prepare(len), data, len);
+            _counters.bytes_copied.add(len);
+            commit(len);
+        }
+
+        char* prepare(size_t n) override {
+            if (_buffer.size() - _end < n) {
+                // 按倍数扩容，resize 的清零开销均摊到多次读取
+                _buffer.resize(std::max(_end + n, _buffer.size() * 2));
+                _counters.buffer_resizes.add(1);
+            }
+            return &_buffer[_end];
+        }
+
+        void commit(size_t n) override {
+            FramingTimer timer(*this);
+            _end += n;
+            _counters.bytes_in.add(n);
+            _counters.peak_buffered.max(_end - _read_pos);
+
+            size_t i = _last_pos;
+            while (i < _end) {
+                if (_resyncing) {
+                    // 跳过坏区域，丢弃的字节随读位置一起被压缩掉
+                    i += resync(_buffer.data() + i, _end - i);
+                    _read_pos = i;
+                    continue;
+                }
+
+                // 批量扫描，直到找到完整的JSON、数据耗尽或越过长度上限
+                size_t message_bytes = _state_tracker.isStarted() ? i - _read_pos - _state_tracker.startOffset() : 0;
+                i += _state_tracker.scan(_buffer.data() + i, scanLimit(message_bytes, _end - i));
+
+                if (_state_tracker.depthExceeded()) {
+                    discard(i, depthError());
+                } else if (_state_tracker.isComplete()) {
+                    // 找到完整的JSON，直接交付缓冲区中的区间；超长的完整消息边界明确，丢弃即可
+                    size_t start = _read_pos + _state_tracker.startOffset();
+                    if (_max_message_size && i - start > _max_message_size) {
+                        reportError(sizeError());
+                    } else {
+                        processFrame(JsonFrame(JsonView(_buffer.data() + start, i - start)));
                     }
 
-                    if (_state_tracker.processChar(c) && _state_tracker.isComplete()) {
-
-                        size_t start = 0;
-
-                        // 找到完整的JSON，提取并处理
-                        std::string json = _buffer.substr(start, i + 1);
-                        json.erase(std::remove_if(json.begin(), json.end(), ::isspace), json.end());
-                        // std::cout << "找到完整的JSON: " << json << std::endl;
-                        processJson(json);
-                        
-                        // 移除已处理的数据
-                        _buffer.erase(0, i + 1);
-                        // std::cout << "剩下的内容: " << _buffer.substr(0, _buffer.length()) << std::endl;
-                        
-                        // 重置状态和索引
+                    // 只推进读位置，不移动剩余数据
+                    _read_pos = i;
+                    _state_tracker.reset();
+                } else if (!_state_tracker.isStarted()) {
+                    // 消息开始前的空白不必保留；不在字符串内时跟踪器没有其它状态，可直接重置
+                    if (!_state_tracker.inString()) {
+                        _read_pos = i;
                         _state_tracker.reset();
-                        i = 0; // 重置索引
-                        
-                        // 跳过前导空白字符
-                        while (i < _buffer.size() && isspace(_buffer[i])) {
-                            i++;
-                        }
-                        
-                        // 如果缓冲区为空或没有新的JSON开始，退出循环
-                        if (i >= _buffer.size() || _buffer[i] != '{') {
-                            std::cout << "没有找到更多的JSON对象" << std::endl;
-                            break;
-                        }
-                        
-                        // Don't increment i here - continue to process the current character
-                    } else {
-                        // Only increment i when we haven't found a complete JSON
-                        i++; 
                     }
+                } else if (_max_message_size && i - _read_pos - _state_tracker.startOffset() > _max_message_size) {
+                    discard(i, sizeError());
                 }
-                
-                // 更新最后处理的位置
-                _last_pos = i;
             }
+
+            // 更新最后处理的位置
+            _last_pos = i;
+            flushBatch();
+            compact();
+        }
+
         void clear() override {
-            _buffer.clear();
+            _end = 0;
+            _read_pos = 0;
             _last_pos = 0;
             _state_tracker.reset();
+            resetResync();
         }
     
-    private:
-        std::string _buffer; // 内部缓冲区
-        size_t _last_pos = 0; // 上次处理的位置
+    protected:
+        const JsonStateTtacker& trackerState() const override {
+            return _state_tracker;
+        }
+
+        JsonStateTtacker& trackerState() override {
+            return _state_tracker;
+        }
+
+    private:
+        // 丢弃 [_read_pos, end) 并开始重新同步
+        void discard(size_t end, const std::string& message) {
+            _read_pos = end;
+            _state_tracker.reset();
+            startResync(message, _buffer[end - 1] == '\n');
+        }
+
+        // 已消费的前缀足够大时才整体前移，均摊每字节 O(1)
+        void compact() {
+            if (_read_pos == 0) return;
+            if (_read_pos == _end) {
+                _end = 0;
+            } else if (_read_pos >= COMPACT_THRESHOLD && _read_pos * 2 >= _end) {
+                std::memmove(&_buffer[0], &_buffer[_read_pos], _end - _read_pos);
+                _counters.bytes_copied.add(_end - _read_pos);
+                _end -= _read_pos;
+            } else {
+                return;
+            }
+            _last_pos -= _read_pos;
+            _read_pos = 0;
+        }
+
+        static const size_t COMPACT_THRESHOLD = 4096; // 触发前移的最小已消费字节数
+
+        std::string _buffer; // 内部缓冲区，[0, _end) 为有效数据，之后为 prepare() 预留的可写区
+        size_t _end = 0; // 有效数据的结束位置
+        size_t _read_pos = 0; // 未消费数据的起始位置
+        size_t _last_pos = 0; // 上次处理的位置
         JsonStateTtacker _state_tracker; // 状态跟踪器
 
 };
 
-
-#if 1
-// 环形缓冲区JSON解析器
-class RingBufferJsonParser : public JsonParserBase {
+/**
+ * @brief 编译期回调的增量解析器
+ *
+ * 分帧方式与 InCrementalJsonParser 相同，但处理函数的类型是模板参数：
+ * 没有虚函数和 std::function 间接调用，处理函数可以被内联，也不为每条消息设置 try/catch。
+ * 处理函数抛出的异常直接传给 addData()/commit() 的调用方，已交付的消息不会重复交付，
+ * 再次调用 addData()/commit() 从下一条消息继续。
+ * 不支持长度与深度上限、压缩等选项，适合可信来源的高频小消息。
+ *
+ * 用法：
+ *   auto parser = makeJsonInlineParser([&](const JsonView& json) { handle(json); });
+ *   parser.addData(data, len);
+ */
+template<typename Handler>
+class JsonInlineParser {
     public:
-        RingBufferJsonParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr, size_t buffer_size = 8192)
-            : JsonParserBase(std::move(json_callback), std::move(error_callback)), 
-              _buffer(buffer_size), 
-              _size(buffer_size) {
-
-              }
-        #if 0
-        void addData(const std::string& data) override {
-            
-            for (char c : data) {
-                _buffer[_tail] = c;
-                _tail = (_tail + 1) % _size;
-                std::cout << "tail = " << _tail << " head = " << _head << std::endl;
-                
-                // 缓冲区已满，需要扩展
-                if (_tail == _head) {
-                    resizeBuffer();
-                }
-                
-                // 处理这个字符
-                if (_state_tracker.processChar(c) && _state_tracker.isComplete()) {
-                    
-                    // std::cout << "找到完整的JSON " << std::endl;
-                    // 找到完整的JSON，提取并处理它
-                    std::string json = extractJson();
-                    // std::cout << "找到完整的JSON: " << json << std::endl;
-                    processJson(json);
-                    
-                    // 重置状态追踪器
-                    _state_tracker.reset();
-                }
+        explicit JsonInlineParser(Handler handler)
+            : _handler(std::move(handler))
+            {}
+
+        void addData(const char* data, size_t len) {
+            if (len == 0) return;
+            std::memcpy(prepare(len), data, len);
+            commit(len);
+        }
+
+        void addData(const std::string& data) {
+            addData(data.data(), data.size());
+        }
+
+        // 同 JsonParserBase::prepare()
+        char* prepare(size_t n) {
+            if (_buffer.size() - _end < n) {
+                _buffer.resize(std::max(_end + n, _buffer.size() * 2));
             }
+            return &_buffer[_end];
         }
-        #endif
 
-        void addData(const std::string& data) override {
-            for (char c : data) {
-                // 先检查下一个位置是否会导致缓冲区已满
-                if ((_tail + 1) % _size == _head) {
-                    resizeBuffer();
-                }
-                
-                _buffer[_tail] = c;
-                _tail = (_tail + 1) % _size;
-                
-                // 处理这个字符
-                if (_state_tracker.processChar(c) && _state_tracker.isComplete()) {
-                    std::string json = extractJson();
-                    processJson(json);
+        // 同 JsonParserBase::commit()
+        void commit(size_t n) {
+            _end += n;
+            size_t i = _last_pos;
+            while (i < _end) {
+                i += _state_tracker.scan(_buffer.data() + i, _end - i);
+                if (_state_tracker.isComplete()) {
+                    size_t start = _read_pos + _state_tracker.startOffset();
+                    // 先推进状态再回调，回调抛出异常时不会重复交付
+                    _read_pos = i;
+                    _last_pos = i;
+                    _state_tracker.reset();
+                    _handler(JsonView(_buffer.data() + start, i - start));
+                } else if (!_state_tracker.isStarted() && !_state_tracker.inString()) {
+                    _read_pos = i;
                     _state_tracker.reset();
                 }
             }
+            _last_pos = i;
+            compact();
         }
-        void clear() override {
-            _head = 0;
-            _tail = 0;
+
+        void clear() {
+            _end = 0;
+            _read_pos = 0;
+            _last_pos = 0;
             _state_tracker.reset();
         }
-    
+
     private:
-        // 从环形缓冲区提取JSON
-        std::string extractJson() {
-            std::string json;
-            bool found_start = false;
-            bool found_end = false;
-            size_t brace_count = 0;
-            size_t bracket_count = 0;
-            bool in_string = false;
-            bool escaped = false;
-            
-            size_t i = _head;
-            while (i != _tail) {
-                char c = _buffer[i];
-                
-                // 修改：检测JSON开始（大括号或中括号）
-                if (!found_start && (c == '{' || c == '[')) {
-                    found_start = true;
-                }
-                
-                if (found_start) {
-                    json.push_back(c);
-                    
-                    // 处理字符串和转义的逻辑保持不变...
-                    
-                    if (!in_string) {
-                        if (c == '{') {
-                            brace_count++;
-                        } else if (c == '}') {
-                            brace_count--;
-                            // 检查是否为对象结束
-                            if (brace_count == 0 && bracket_count == 0) {
-                                found_end = true;
-                                _head = (i + 1) % _size;
-                                break;
-                            }
-                        } else if (c == '[') {
-                            bracket_count++;
-                        } else if (c == ']') {
-                            bracket_count--;
-                            // 添加：检查是否为数组结束
-                            if (brace_count == 0 && bracket_count == 0) {
-                                found_end = true;
-                                _head = (i + 1) % _size;
-                                break;
-                            }
-                        }
-                    }
-                }
-                
-                i = (i + 1) % _size;
-            }
-            
-            if (!found_end) {
-                return ""; // 没有找到完整的JSON
+        void compact() {
+            if (_read_pos == 0) return;
+            if (_read_pos == _end) {
+                _end = 0;
+            } else if (_read_pos >= COMPACT_THRESHOLD && _read_pos * 2 >= _end) {
+                std::memmove(&_buffer[0], &_buffer[_read_pos], _end - _read_pos);
+                _end -= _read_pos;
+            } else {
+                return;
             }
-            
-            return json;
-        }
-        // std::string extractJson() {
-        //     std::string json;
-        //     bool found_start = false;
-        //     bool found_end = false;
-        //     size_t brace_count = 0;
-        //     bool in_string = false;
-        //     bool escaped = false;
-        //     std::cout << "[DEBUG] _buffer: \"";
-        //     for (size_t j = 0; j < _buffer.size(); ++j) {
-        //         std::cout << _buffer[j];
-        //     }
-        //     std::cout << "\"" << std::endl;
-        //     size_t i = _head;
-        //     while (i != _tail) {
-        //         char c = _buffer[i];
-                
-        //         // std::cout <<"i = "<<i <<" "<<"" << _buffer[i]; 
-        //         if (!found_start && c == '{') {
-        //             found_start = true;
-        //         }
-                
-        //         if (found_start) {
-        //             json.push_back(c);
-                    
-        //             if (escaped) {
-        //                 escaped = false;
-        //             } else if (c == '\\') {
-        //                 escaped = true;
-        //             } else if (c == '"') {
-        //                 in_string = !in_string;
-        //             } else if (!in_string) {
-        //                 if (c == '{') {
-        //                     brace_count++;
-        //                 } else if (c == '}') {
-        //                     brace_count--;
-        //                     if (brace_count == 0) {
-        //                         found_end = true;
-        //                         _head = (i + 1) % _size; // 更新头指针
-        //                         break;
-        //                     }
-        //                 }
-        //             }
-        //         }
-                
-        //         i = (i + 1) % _size;
-        //     }
-            
-        //     if (!found_end) {
-        //         // 没有找到完整的JSON
-        //         return "";
-        //     }
-            
-        //     return json;
-        // }
-      #if 0  
+            _last_pos -= _read_pos;
+            _read_pos = 0;
+        }
 
+        static const size_t COMPACT_THRESHOLD = 4096;
 
-        void resizeBuffer() {
-            std::cout << "扩展缓冲区" << std::endl;
-            size_t new_size = _size * 2;
-            std::vector<char> new_buffer(new_size);
-            
-            // 计算当前缓冲区中的数据量
-            // size_t data_size = (_tail >= _head) ? 
-            //                    (_tail - _head) : 
-            //                    (_size - _head + _tail);
-            // std::cout << "当前数据量: " << data_size << std::endl;
-            std::cout << "当前缓冲区大小: " << _size << std::endl;
-            size_t data_size = (_tail + _size - _head)-1;
-            std::cout << "当前数据量: " << data_size << std::endl;
-            // 复制数据到新缓冲区的开始位置
-            size_t idx = 0;
-            for (size_t i = _head; i != _tail; i = (i + 1) % _size) {
-                new_buffer[idx++] = _buffer[i];
-            }
-            // std::copy(_buffer.begin(), _buffer.end(), new_buffer.begin());
-            // 更新buffer和指针
-            _buffer = std::move(new_buffer);
-            _head = 0;
-            _tail = idx;
-            _size = new_size;
-        }
-        #endif
-
-        void resizeBuffer() {
-            size_t new_size = _size * 2;
-            std::vector<char> new_buffer(new_size);
-            
-            // 正确计算当前缓冲区中的数据量
-            size_t data_size = (_tail >= _head) ? (_tail - _head) : (_size - _head + _tail);
-            
-            // 复制数据到新缓冲区的开始位置
-            size_t idx = 0;
-            size_t i = _head;
-            while (i != _tail) {
-                new_buffer[idx++] = _buffer[i];
-                i = (i + 1) % _size;
-            }
-            
-            // 更新buffer和指针
-            _buffer = std::move(new_buffer);
-            _head = 0;
-            _tail = idx;
-            _size = new_size;
-        }
-        std::vector<char> _buffer;   // 环形缓冲区
-        size_t _size;                // 缓冲区大小
-        size_t _head = 0;            // 头指针
-        size_t _tail = 0;            // 尾指针
-        JsonStateTtacker _state_tracker;   // 状态追踪器
+        Handler _handler;
+        std::string _buffer;             // [0, _end) 为有效数据
+        size_t _end = 0;
+        size_t _read_pos = 0;            // 未消费数据的起始位置
+        size_t _last_pos = 0;            // 上次处理的位置
+        JsonStateTtacker _state_tracker;
 };
-#endif 
 
+// 推导处理函数类型，便于传入 lambda
+template<typename Handler>
+JsonInlineParser<Handler> makeJsonInlineParser(Handler handler) {
+    return JsonInlineParser<Handler>(std::move(handler));
+}
 
-#if 0
+// 分段缓冲区JSON解析器
+// 单遍处理：在输入数据上扫描，只把消息起点之后的字节写入缓冲区。
+// 缓冲区是由内存池中固定大小分段串成的链：空间不足时挂接一个新分段，已写入的数据不搬移；
+// 消息交付后，除写入位置所在的分段外全部归还内存池。配合 setMaxMessageSize()，
+// 内存和单次延迟都有上界。
+// 消息落在一个分段内时直接交付，跨两个分段时以两段视图交付，跨更多分段时拼接到暂存区后交付
 class RingBufferJsonParser : public JsonParserBase {
     public:
-        // Fixed-size chunk for memory pool allocation
+        // 内存池中的固定大小分段
         struct BufferChunk {
-            static const size_t SIZE = 1024;
+            enum { SIZE = 16 * 1024 };
             char data[SIZE];
         };
-        
-        RingBufferJsonParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr, size_t buffer_size = 8192)
+
+        // buffer_size 决定内存池每次向系统申请的分段数；max_message_size 为 0 表示不限制
+        RingBufferJsonParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr,
+                             size_t buffer_size = 8192, size_t max_message_size = 0)
             : JsonParserBase(std::move(json_callback), std::move(error_callback)),
-              _chunk_pool(32) // Allocate 32 chunks at a time for efficiency
-        {
-            // Calculate initial number of chunks needed
-            size_t num_chunks = (buffer_size + BufferChunk::SIZE - 1) / BufferChunk::SIZE;
-            
-            // Ensure at least one chunk
-            if (num_chunks == 0) num_chunks = 1;
-            
-            // Allocate initial chunks from memory pool
-            _chunks.reserve(num_chunks);
-            for (size_t i = 0; i < num_chunks; ++i) {
-                _chunks.push_back(_chunk_pool.construct());
-            }
-            
-            _capacity = num_chunks * BufferChunk::SIZE;
+              _pool(std::max<size_t>(2, (buffer_size + BufferChunk::SIZE - 1) / BufferChunk::SIZE)) {
+            setMaxMessageSize(max_message_size);
         }
-        
+
         ~RingBufferJsonParser() {
-            // Free all chunks back to memory pool
-            for (auto* chunk : _chunks) {
-                _chunk_pool.destroy(chunk);
+            releaseAll();
+        }
+
+        using JsonParserBase::addData;
+
+        void addData(const char* p, size_t len) override {
+            FramingTimer timer(*this);
+            _counters.bytes_in.add(len);
+            size_t pos = 0;
+            while (pos < len) {
+                if (_resyncing) {
+                    pos += resync(p + pos, len - pos);
+                    continue;
+                }
+                const bool started = _state_tracker.isStarted();
+                const size_t consumed_before = _state_tracker.consumed();
+                size_t n = _state_tracker.scan(p + pos, scanLimit(started ? _message_size : 0, len - pos));
+
+                if (_state_tracker.depthExceeded()) {
+                    dropMessage(depthError());
+                } else if (_state_tracker.isStarted()) {
+                    // 消息在本段内开始时，跳过起点之前的空白/杂质
+                    size_t skip = started ? 0 : _state_tracker.startOffset() - consumed_before;
+                    if (_max_message_size && _message_size + n - skip > _max_message_size) {
+                        dropMessage(sizeError(), p[pos + n - 1] == '\n');
+                    } else {
+                        append(p + pos + skip, n - skip);
+                    }
+                }
+                pos += n;
+
+                if (_state_tracker.isComplete()) {
+                    finishMessage();
+                }
             }
+            flushBatch();
         }
-        
-        void addData(const std::string& data) override {
-            for (char c : data) {
-                // Check if buffer is full
-                if ((_tail + 1) % _capacity == _head) {
-                    expandBuffer();
+
+        // 尾段剩余空间足够时直接返回尾段；消息未开始时换一个新分段；
+        // 超过分段大小的请求退化为暂存区，commit 时拷贝
+        char* prepare(size_t n) override {
+            if (n > BufferChunk::SIZE) {
+                _staging.resize(n);
+                _staged = true;
+                return _staging.data();
+            }
+            _staged = false;
+            if (_segments.empty() || BufferChunk::SIZE - _segments.back().end < n) {
+                if (_message_size == 0) {
+                    releaseAll();
                 }
-                
-                // Store character in the appropriate chunk
-                size_t chunk_idx = _tail / BufferChunk::SIZE;
-                size_t pos = _tail % BufferChunk::SIZE;
-                _chunks[chunk_idx]->data[pos] = c;
-                
-                _tail = (_tail + 1) % _capacity;
-                
-                // Process character
-                if (_state_tracker.processChar(c) && _state_tracker.isComplete()) {
-                    std::string json = extractJson();
-                    processJson(json);
-                    _state_tracker.reset();
+                linkSegment();
+            }
+            Segment& tail = _segments.back();
+            return tail.chunk->data + tail.end;
+        }
+
+        // 数据已在尾段中：消息开始前的空白直接跳过，完整消息原地交付
+        void commit(size_t n) override {
+            if (_staged) {
+                _staged = false;
+                addData(_staging.data(), n);
+                return;
+            }
+            FramingTimer timer(*this);
+            _counters.bytes_in.add(n);
+            size_t pos = _segments.back().end;
+            const size_t end = pos + n;
+            while (pos < end) {
+                Segment& tail = _segments.back();
+                if (_resyncing) {
+                    pos += resync(tail.chunk->data + pos, end - pos);
+                    tail.begin = pos;
+                    tail.end = pos;
+                    continue;
+                }
+                const bool started = _state_tracker.isStarted();
+                const size_t consumed_before = _state_tracker.consumed();
+                const size_t scan_begin = pos;
+                pos += _state_tracker.scan(tail.chunk->data + pos, scanLimit(started ? _message_size : 0, end - pos));
+
+                if (_state_tracker.depthExceeded()) {
+                    tail.end = pos;
+                    dropMessage(depthError());
+                } else if (!_state_tracker.isStarted()) {
+                    // 消息间的空白，不计入缓存
+                    tail.begin = pos;
+                    tail.end = pos;
+                } else {
+                    size_t from = scan_begin;
+                    if (!started) {
+                        // 消息不跨调用开始时，链中只有尾段
+                        from = scan_begin + _state_tracker.startOffset() - consumed_before;
+                        tail.begin = from;
+                    }
+                    tail.end = pos;
+                    _message_size += pos - from;
+                    _counters.peak_buffered.max(_message_size);
+                    if (_max_message_size && _message_size > _max_message_size) {
+                        dropMessage(sizeError(), tail.chunk->data[pos - 1] == '\n');
+                    }
+                }
+
+                if (_state_tracker.isComplete()) {
+                    finishMessage();
                 }
             }
+            flushBatch();
         }
-        
+
         void clear() override {
-            _head = 0;
-            _tail = 0;
+            releaseAll();
+            _message_size = 0;
+            _staged = false;
             _state_tracker.reset();
+            resetResync();
         }
-    
+
+        // 当前挂接的分段总字节数
+        size_t capacity() const {
+            return _segments.size() * BufferChunk::SIZE;
+        }
+
+        // 当前挂接的分段数
+        size_t segmentCount() const {
+            return _segments.size();
+        }
+
+    protected:
+        const JsonStateTtacker& trackerState() const override {
+            return _state_tracker;
+        }
+
+        JsonStateTtacker& trackerState() override {
+            return _state_tracker;
+        }
+
+        // 每次读取不超过尾段剩余空间，剩余太少时读满一个新分段
+        size_t readSizeHint(size_t max_bytes) const override {
+            size_t room = _segments.empty() ? 0 : BufferChunk::SIZE - _segments.back().end;
+            if (room < MIN_READ) {
+                room = BufferChunk::SIZE;
+            }
+            return std::min(max_bytes, room);
+        }
+
     private:
-        // Extract JSON from chunked buffer
-        std::string extractJson() {
-            std::string json;
-            bool found_start = false;
-            bool found_end = false;
-            size_t brace_count = 0;
-            size_t bracket_count = 0;
-            bool in_string = false;
-            bool escaped = false;
-            
-            size_t i = _head;
-            while (i != _tail) {
-                size_t chunk_idx = i / BufferChunk::SIZE;
-                size_t pos = i % BufferChunk::SIZE;
-                char c = _chunks[chunk_idx]->data[pos];
-                
-                if (!found_start && (c == '{' || c == '[')) {
-                    found_start = true;
+        struct Segment {
+            BufferChunk* chunk;
+            size_t begin;            // 当前消息在本段内的起点
+            size_t end;              // 本段已写入的结束位置
+        };
+
+        static const size_t MIN_READ = 1024;   // readFrom 单次读取的最小字节数
+
+        void linkSegment() {
+            Segment seg;
+            seg.chunk = _pool.allocate();
+            _counters.buffer_resizes.add(1);
+            seg.begin = 0;
+            seg.end = 0;
+            _segments.push_back(seg);
+        }
+
+        void releaseAll() {
+            for (const auto& seg : _segments) {
+                _pool.deallocate(seg.chunk);
+            }
+            _segments.clear();
+        }
+
+        // 当前消息已交付或丢弃：归还写入位置之前的分段，尾段留给后续消息
+        void releaseMessage() {
+            if (_segments.size() > 1) {
+                // 归还的分段可能被随后的消息复用，先交付引用它们的消息
+                flushBatch();
+            }
+            while (_segments.size() > 1) {
+                _pool.deallocate(_segments.front().chunk);
+                _segments.pop_front();
+            }
+            if (!_segments.empty()) {
+                _segments.back().begin = _segments.back().end;
+            }
+            _message_size = 0;
+        }
+
+        // 把消息字节追加到链尾，尾段写满时挂接新分段
+        void append(const char* p, size_t n) {
+            if (_message_size == 0 && !_segments.empty()) {
+                _segments.back().begin = _segments.back().end;
+            }
+            _message_size += n;
+            _counters.peak_buffered.max(_message_size);
+            while (n > 0) {
+                if (_segments.empty() || _segments.back().end == BufferChunk::SIZE) {
+                    linkSegment();
                 }
-                
-                if (found_start) {
-                    json.push_back(c);
-                    
-                    if (escaped) {
-                        escaped = false;
-                    } else if (c == '\\') {
-                        escaped = true;
-                    } else if (c == '"') {
-                        in_string = !in_string;
-                    } else if (!in_string) {
-                        if (c == '{') {
-                            brace_count++;
-                        } else if (c == '}') {
-                            brace_count--;
-                            if (brace_count == 0 && bracket_count == 0) {
-                                found_end = true;
-                                _head = (i + 1) % _capacity;
-                                break;
-                            }
-                        } else if (c == '[') {
-                            bracket_count++;
-                        } else if (c == ']') {
-                            bracket_count--;
-                            if (brace_count == 0 && bracket_count == 0) {
-                                found_end = true;
-                                _head = (i + 1) % _capacity;
-                                break;
-                            }
-                        }
+                Segment& tail = _segments.back();
+                size_t k = std::min(n, BufferChunk::SIZE - tail.end);
+                std::memcpy(tail.chunk->data + tail.end, p, k);
+                _counters.bytes_copied.add(k);
+                tail.end += k;
+                p += k;
+                n -= k;
+            }
+        }
+
+        // 丢弃当前消息；消息已完整时边界明确，否则开始重新同步
+        void dropMessage(const std::string& message, bool line_start = false) {
+            const bool complete = _state_tracker.isComplete();
+            releaseMessage();
+            _state_tracker.reset();
+            if (complete) {
+                reportError(message);
+            } else {
+                startResync(message, line_start);
+            }
+        }
+
+        void finishMessage() {
+            processFrame(makeFrame());
+            releaseMessage();
+            _state_tracker.reset();
+        }
+
+        // 当前消息的视图：跳过空分段，最多两段直接引用，否则拼接到暂存区
+        JsonFrame makeFrame() {
+            JsonView spans[2];
+            size_t count = 0;
+            for (const auto& seg : _segments) {
+                if (seg.end == seg.begin) continue;
+                if (count == 2) {
+                    _scratch.resize(_message_size);
+                    _counters.bytes_copied.add(_message_size);
+                    char* out = &_scratch[0];
+                    for (const auto& s : _segments) {
+                        std::memcpy(out, s.chunk->data + s.begin, s.end - s.begin);
+                        out += s.end - s.begin;
                     }
+                    return JsonFrame(JsonView(_scratch.data(), _scratch.size()));
                 }
-                
-                i = (i + 1) % _capacity;
+                spans[count++] = JsonView(seg.chunk->data + seg.begin, seg.end - seg.begin);
             }
-            
-            if (!found_end) {
-                return ""; // No complete JSON found
+            if (count == 2) {
+                return JsonFrame(spans[0], spans[1]);
             }
-            
-            return json;
+            return JsonFrame(spans[0]);
         }
-        
-        // Expand buffer by allocating more chunks from memory pool
-        void expandBuffer() {
-            size_t old_capacity = _capacity;
-            size_t old_chunks = _chunks.size();
-            
-            // Reserve space for new chunks
-            _chunks.reserve(old_chunks * 2);
-            
-            // Allocate new chunks (double the buffer size)
-            for (size_t i = 0; i < old_chunks; ++i) {
-                _chunks.push_back(_chunk_pool.construct());
+
+        CRAFTRIX::MemoryPool<BufferChunk> _pool;   // 分段内存池
+        std::deque<Segment> _segments;             // 当前消息占用的分段，末尾为写入位置
+        size_t _message_size = 0;                  // 当前消息已缓存的字节数
+        std::string _scratch;                      // 跨多个分段的消息拼接区
+        std::vector<char> _staging;                // 超过分段大小的 prepare 暂存区
+        bool _staged = false;                      // 上一次 prepare 返回的是暂存区
+        JsonStateTtacker _state_tracker;           // 状态追踪器
+};
+
+// 按分隔符分帧的解析器基类
+// 不逐字节跟踪括号，只按格式自带的边界（换行、长度头、RS）切出消息，消息以缓冲区或映射区的视图交付。
+// 缓冲区布局与 InCrementalJsonParser 相同；子类实现 frameRange() 在一段连续数据上切分。
+// 默认不校验消息内容，setValidate(true) 或设置了最大嵌套深度时，在交付前对切出的消息检查括号配对
+class DelimitedJsonParser : public JsonParserBase {
+    public:
+        DelimitedJsonParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr)
+            : JsonParserBase(std::move(json_callback), std::move(error_callback))
+            {}
+
+        using JsonParserBase::addData;
+
+        void addData(const char* data, size_t len) override {
+            if (len == 0) return;
+            FramingTimer timer(*this);
+            std::memcpy(prepare(len), data, len);
+            _counters.bytes_copied.add(len);
+            commit(len);
+        }
+
+        char* prepare(size_t n) override {
+            if (_buffer.size() - _end < n) {
+                _buffer.resize(std::max(_end + n, _buffer.size() * 2));
+                _counters.buffer_resizes.add(1);
             }
-            
-            _capacity = _chunks.size() * BufferChunk::SIZE;
-            
-            // Reorganize data if needed
-            if (_head > _tail) {
-                // Data wraps around, need to reorganize
-                std::vector<char> temp;
-                temp.reserve(old_capacity);
-                
-                // Copy data from old buffer
-                for (size_t i = _head; i < old_capacity; ++i) {
-                    size_t chunk_idx = i / BufferChunk::SIZE;
-                    size_t pos = i % BufferChunk::SIZE;
-                    temp.push_back(_chunks[chunk_idx]->data[pos]);
+            return &_buffer[_end];
+        }
+
+        void commit(size_t n) override {
+            FramingTimer timer(*this);
+            _end += n;
+            _counters.bytes_in.add(n);
+            _counters.peak_buffered.max(_end - _read_pos);
+            _read_pos += frameRange(_buffer.data() + _read_pos, _end - _read_pos, false);
+            flushBatch();
+            compact();
+        }
+
+        void clear() override {
+            _end = 0;
+            _read_pos = 0;
+            _validator.reset();
+            resetFraming();
+        }
+
+        void finish() override {
+            FramingTimer timer(*this);
+            if (_end > _read_pos) {
+                frameRange(_buffer.data() + _read_pos, _end - _read_pos, true);
+                flushBatch();
+            }
+            clear();
+        }
+
+        // 映射整个文件，直接在映射区上按分隔符切分
+        // 缓冲区中有上次剩下的不完整消息时，先按块拷贝补全它，直到缓冲区里只剩来自文件的字节，
+        // 再丢掉这部分拷贝，从文件中对应的位置继续在映射区上分帧
+        bool parseFile(const std::string& path) override {
+            FramingTimer timer(*this);
+            JsonMappedFile file;
+            if (!file.open(path)) {
+                reportError("无法打开文件: " + path);
+                return false;
+            }
+            const char* data = file.data();
+            const size_t len = file.size();
+            size_t pos = 0;
+
+            size_t chunk = 4096;
+            while (pos < len && _end > _read_pos) {
+                size_t n = std::min(chunk, len - pos);
+                addData(data + pos, n);
+                pos += n;
+                chunk *= 2;
+                size_t buffered = _end - _read_pos;
+                if (buffered <= pos) {
+                    // 这部分字节将在映射区上重新分帧
+                    pos -= buffered;
+                    _counters.bytes_in.sub(buffered);
+                    _end = 0;
+                    _read_pos = 0;
+                    rewind();
+                    break;
                 }
-                
-                for (size_t i = 0; i < _tail; ++i) {
-                    size_t chunk_idx = i / BufferChunk::SIZE;
-                    size_t pos = i % BufferChunk::SIZE;
-                    temp.push_back(_chunks[chunk_idx]->data[pos]);
+            }
+
+            const size_t mapped_begin = pos;
+            size_t end = pos;
+            while (end < len) {
+                end = std::min(len, end + FILE_WINDOW);
+                file.willNeed(end, FILE_WINDOW);
+                pos += frameRange(data + pos, end - pos, false);
+                flushBatch();
+                file.dontNeed(pos);
+            }
+            _counters.bytes_in.add(pos - mapped_begin);
+            // 末尾不完整的消息拷贝进缓冲区，扫描进度仍然有效，不会重复扫描
+            addData(data + pos, len - pos);
+            return true;
+        }
+
+        // 开启后交付前检查消息是完整的JSON对象或数组，不完整的报错并丢弃（默认关闭）
+        void setValidate(bool validate) {
+            _validate = validate;
+        }
+
+    protected:
+        const JsonStateTtacker& trackerState() const override {
+            return _validator;
+        }
+
+        JsonStateTtacker& trackerState() override {
+            return _validator;
+        }
+
+        // 在 [data, data+len) 上切出并交付完整消息，返回消费的字节数，剩余部分下次从头传入
+        // at_eof 为真表示输入已结束，子类交付或报告最后一段数据
+        virtual size_t frameRange(const char* data, size_t len, bool at_eof) = 0;
+
+        // 缓冲区中未消费的数据将从头重新传入：丢弃对这部分数据的扫描进度
+        virtual void rewind() = 0;
+
+        // 清除全部分帧状态
+        virtual void resetFraming() = 0;
+
+        // 去除首尾空白后交付一条消息：检查长度，按需校验括号
+        // scalar 为真时消息是标量（数字、字符串、字面量），不做括号校验
+        void deliverMessage(const char* data, size_t len, bool scalar = false) {
+            while (len && isSpace(data[0])) {
+                ++data;
+                --len;
+            }
+            while (len && isSpace(data[len - 1])) {
+                --len;
+            }
+            if (len == 0) return;
+            if (_max_message_size && len > _max_message_size) {
+                reportError(sizeError());
+                return;
+            }
+            if (!scalar && (_validate || _max_depth) && !validate(data, len)) {
+                return;
+            }
+            processFrame(JsonFrame(JsonView(data, len)));
+        }
+
+        static bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+    private:
+        bool validate(const char* data, size_t len) {
+            _validator.reset();
+            size_t n = _validator.scan(data, len);
+            if (_validator.depthExceeded()) {
+                reportError(depthError());
+                return false;
+            }
+            if (!_validator.isComplete() || _validator.startOffset() != 0 || n != len) {
+                reportError("消息不是完整的JSON对象或数组，已丢弃");
+                return false;
+            }
+            return true;
+        }
+
+        void compact() {
+            if (_read_pos == 0) return;
+            if (_read_pos == _end) {
+                _end = 0;
+            } else if (_read_pos >= COMPACT_THRESHOLD && _read_pos * 2 >= _end) {
+                std::memmove(&_buffer[0], &_buffer[_read_pos], _end - _read_pos);
+                _counters.bytes_copied.add(_end - _read_pos);
+                _end -= _read_pos;
+            } else {
+                return;
+            }
+            _read_pos = 0;
+        }
+
+        static const size_t COMPACT_THRESHOLD = 4096;
+
+        std::string _buffer;             // [0, _end) 为有效数据
+        size_t _end = 0;
+        size_t _read_pos = 0;            // 未消费数据的起始位置
+        bool _validate = false;
+        JsonStateTtacker _validator;     // 交付前校验用
+};
+
+// 换行分隔的JSON（NDJSON / JSON Lines）
+// 每行一条消息，用 memchr 查找换行，不逐字节判断括号；空行跳过，行尾的 '\r' 去除。
+// 超过 setMaxMessageSize() 的行在找到换行之前即被丢弃，缓冲区不会无限增长
+class NdjsonParser : public DelimitedJsonParser {
+    public:
+        NdjsonParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr)
+            : DelimitedJsonParser(std::move(json_callback), std::move(error_callback))
+            {}
+
+    protected:
+        size_t frameRange(const char* data, size_t len, bool at_eof) override {
+            size_t pos = 0;
+            while (pos < len) {
+                const void* found = std::memchr(data + pos + _scanned, '\n', len - pos - _scanned);
+                if (!found) break;
+                const size_t eol = static_cast<const char*>(found) - data;
+                if (_skipping) {
+                    _skipping = false;
+                } else {
+                    deliverMessage(data + pos, eol - pos);
                 }
-                
-                // Reset head and tail
-                _head = 0;
-                _tail = temp.size();
-                
-                // Copy data back to buffer
-                for (size_t i = 0; i < temp.size(); ++i) {
-                    size_t chunk_idx = i / BufferChunk::SIZE;
-                    size_t pos = i % BufferChunk::SIZE;
-                    _chunks[chunk_idx]->data[pos] = temp[i];
+                pos = eol + 1;
+                _scanned = 0;
+            }
+            if (pos == len) return pos;
+
+            if (_skipping) {
+                return len;     // 超长行的剩余部分直接丢弃
+            }
+            if (at_eof) {
+                deliverMessage(data + pos, len - pos);
+                return len;
+            }
+            _scanned = len - pos;
+            if (_max_message_size && _scanned > _max_message_size) {
+                reportError(sizeError());
+                _skipping = true;
+                _scanned = 0;
+                return len;
+            }
+            return pos;
+        }
+
+        void rewind() override {
+            _scanned = 0;
+        }
+
+        void resetFraming() override {
+            _scanned = 0;
+            _skipping = false;
+        }
+
+    private:
+        size_t _scanned = 0;       // 当前行已查找过换行的字节数
+        bool _skipping = false;    // 正在丢弃超长行，直到下一个换行
+};
+
+// 长度前缀分帧：每条消息前有 4 字节大端无符号长度，随后是该长度的 JSON 字节
+// 超过 setMaxMessageSize() 的消息按长度整段跳过，不缓存
+class LengthPrefixedJsonParser : public DelimitedJsonParser {
+    public:
+        enum { HEADER_SIZE = 4 };
+
+        LengthPrefixedJsonParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr)
+            : DelimitedJsonParser(std::move(json_callback), std::move(error_callback))
+            {}
+
+        // 生成长度头，追加到 out
+        static void appendHeader(std::string& out, uint32_t len) {
+            out.push_back(static_cast<char>((len >> 24) & 0xFF));
+            out.push_back(static_cast<char>((len >> 16) & 0xFF));
+            out.push_back(static_cast<char>((len >> 8) & 0xFF));
+            out.push_back(static_cast<char>(len & 0xFF));
+        }
+
+    protected:
+        size_t frameRange(const char* data, size_t len, bool at_eof) override {
+            size_t pos = 0;
+            while (pos < len) {
+                if (_skip) {
+                    size_t n = std::min(_skip, len - pos);
+                    _skip -= n;
+                    pos += n;
+                    continue;
+                }
+                if (len - pos < HEADER_SIZE) break;
+                const unsigned char* h = reinterpret_cast<const unsigned char*>(data + pos);
+                const size_t body = (static_cast<size_t>(h[0]) << 24) | (static_cast<size_t>(h[1]) << 16) |
+                                    (static_cast<size_t>(h[2]) << 8) | static_cast<size_t>(h[3]);
+                if (_max_message_size && body > _max_message_size) {
+                    reportError(sizeError());
+                    _skip = body;
+                    pos += HEADER_SIZE;
+                    continue;
                 }
+                if (len - pos - HEADER_SIZE < body) break;
+                deliverMessage(data + pos + HEADER_SIZE, body);
+                pos += HEADER_SIZE + body;
             }
+            if (at_eof && pos < len) {
+                reportError("输入结束时消息不完整");
+                return len;
+            }
+            return pos;
         }
-        
-        std::vector<BufferChunk*> _chunks;     // Array of chunk pointers
-        size_t _capacity = 0;                  // Total capacity in bytes
-        size_t _head = 0;                      // Head position
-        size_t _tail = 0;                      // Tail position
-        JsonStateTtacker _state_tracker;       // JSON state tracker
-        MemoryPool<BufferChunk> _chunk_pool;   // Memory pool for chunk allocation
+
+        void rewind() override {}
+
+        void resetFraming() override {
+            _skip = 0;
+        }
+
+    private:
+        size_t _skip = 0;          // 超长消息尚未跳过的字节数
+};
+
+// RFC 7464 JSON 文本序列（application/json-seq）：每条记录为 RS(0x1E) + JSON + LF
+// RS 不会出现在合法的 JSON 中，用 memchr 定位记录边界；记录内按括号确定消息结束，
+// 消息结束即交付，不必等下一个 RS。在结束之前遇到下一个 RS 的记录视为被截断，报错并丢弃，
+// 随后从该 RS 处继续。首个非空白字节不是括号的记录为标量（数字、字符串、字面量），
+// 标量内不会出现未转义的换行，按 RS 到 LF 整段交付；记录外的字节被忽略
+class JsonSeqParser : public DelimitedJsonParser {
+    public:
+        enum { RS = 0x1E };
+
+        JsonSeqParser(JsonCallback json_callback, ErrorCallback error_callback = nullptr)
+            : DelimitedJsonParser(std::move(json_callback), std::move(error_callback))
+            {}
+
+    protected:
+        size_t frameRange(const char* data, size_t len, bool at_eof) override {
+            size_t consumed = 0;        // 当前记录在 RS 之后的起点，之前的字节已处理完
+            size_t pos = _scanned;
+            while (pos < len) {
+                const void* found = std::memchr(data + pos, RS, len - pos);
+                const size_t limit = found ? static_cast<size_t>(static_cast<const char*>(found) - data) : len;
+                if (_in_record && !_record_done && !_scalar && !_record.isStarted()) {
+                    // 记录的首个非空白字节决定它是容器还是标量
+                    size_t first = pos;
+                    while (first < limit && isSpace(data[first])) ++first;
+                    _scalar = first < limit && data[first] != '{' && data[first] != '[';
+                }
+                if (_in_record && !_record_done && _scalar) {
+                    const void* lf = std::memchr(data + pos, '\n', limit - pos);
+                    if (lf) {
+                        const size_t eol = static_cast<const char*>(lf) - data;
+                        deliverMessage(data + consumed, eol - consumed, true);
+                        _record_done = true;
+                    } else {
+                        pos = limit;
+                        if (_max_message_size && pos - consumed > _max_message_size) {
+                            reportError(sizeError());
+                            _record_done = true;
+                        }
+                    }
+                } else if (_in_record && !_record_done) {
+                    pos += _record.scan(data + pos, limit - pos);
+                    if (_record.depthExceeded()) {
+                        reportError(depthError());
+                        _record_done = true;
+                    } else if (_record.isComplete()) {
+                        size_t start = consumed + _record.startOffset();
+                        if (_max_message_size && pos - start > _max_message_size) {
+                            reportError(sizeError());
+                        } else {
+                            processFrame(JsonFrame(JsonView(data + start, pos - start)));
+                        }
+                        _record_done = true;
+                    } else if (_max_message_size && _record.isStarted() &&
+                               pos - consumed - _record.startOffset() > _max_message_size) {
+                        reportError(sizeError());
+                        _record_done = true;
+                    }
+                }
+                // 记录外或记录已处理完：余下的字节直接跳到下一个 RS
+                if (!_in_record || _record_done) {
+                    pos = limit;
+                    consumed = pos;
+                }
+                if (!found) break;
+
+                if (_in_record && !_record_done && (_scalar || _record.isStarted())) {
+                    reportError("记录被截断，已丢弃");
+                }
+                startRecord();
+                pos = limit + 1;
+                consumed = pos;
+            }
+            if (at_eof) {
+                if (_in_record && !_record_done && (_scalar || _record.isStarted())) {
+                    reportError("记录被截断，已丢弃");
+                }
+                _scanned = 0;
+                return len;
+            }
+            _scanned = pos - consumed;
+            return consumed;
+        }
+
+        void rewind() override {
+            _scanned = 0;
+            if (_in_record && !_record_done) {
+                startRecord();
+            }
+        }
+
+        void resetFraming() override {
+            _scanned = 0;
+            _in_record = false;
+            _record_done = false;
+            _scalar = false;
+            _record.reset();
+        }
+
+    private:
+        void startRecord() {
+            _in_record = true;
+            _record_done = false;
+            _scalar = false;
+            _record.reset();
+            _record.setMaxDepth(static_cast<int>(_max_depth));
+        }
+
+        size_t _scanned = 0;           // 当前记录已扫描的字节数
+        bool _in_record = false;       // 已遇到 RS
+        bool _record_done = false;     // 当前记录已交付或丢弃，跳到下一个 RS
+        bool _scalar = false;          // 当前记录是标量，交付到 LF 为止
+        JsonStateTtacker _record;      // 当前记录的括号状态
 };
 
-#endif
-// JSON解析器工厂
 class JsonParserFactory {
     public:
         enum class ParserType {
-            INCREMENTAL,   // 增量式解析器
-            RING_BUFFER    // 环形缓冲区解析器
+            INCREMENTAL,       // 增量式解析器
+            RING_BUFFER,       // 分段缓冲区解析器（内存池分段链）
+            NDJSON,            // 换行分隔，按 memchr 切分
+            LENGTH_PREFIXED,   // 4 字节大端长度前缀
+            JSON_SEQ           // RFC 7464 JSON 文本序列
         };
         
         // 创建JSON解析器
@@ -684,10 +1871,48 @@ class JsonParserFactory {
                 case ParserType::RING_BUFFER:
                     return std::make_unique<RingBufferJsonParser>(
                         std::move(json_callback), std::move(error_callback), buffer_size);
+
+                case ParserType::NDJSON:
+                    return std::make_unique<NdjsonParser>(
+                        std::move(json_callback), std::move(error_callback));
+
+                case ParserType::LENGTH_PREFIXED:
+                    return std::make_unique<LengthPrefixedJsonParser>(
+                        std::move(json_callback), std::move(error_callback));
+
+                case ParserType::JSON_SEQ:
+                    return std::make_unique<JsonSeqParser>(
+                        std::move(json_callback), std::move(error_callback));
                 
                 default:
                     throw std::invalid_argument("无效的解析器类型");
             }
         }
+
+        // 创建零拷贝回调的JSON解析器
+        static std::unique_ptr<JsonParserBase> createViewParser(
+            ParserType type,
+            JsonParserBase::JsonViewCallback view_callback,
+            JsonParserBase::ErrorCallback error_callback = nullptr,
+            size_t buffer_size = 8192) {
+
+            std::unique_ptr<JsonParserBase> parser =
+                createParser(type, nullptr, std::move(error_callback), buffer_size);
+            parser->setViewCallback(std::move(view_callback));
+            return parser;
+        }
+
+        // 创建批量回调的JSON解析器
+        static std::unique_ptr<JsonParserBase> createBatchParser(
+            ParserType type,
+            JsonParserBase::JsonBatchCallback batch_callback,
+            JsonParserBase::ErrorCallback error_callback = nullptr,
+            size_t buffer_size = 8192) {
+
+            std::unique_ptr<JsonParserBase> parser =
+                createParser(type, nullptr, std::move(error_callback), buffer_size);
+            parser->setBatchCallback(std::move(batch_callback));
+            return parser;
+        }
     };
 #endif // __JSON_PARSER_H__
\ No newline at end of file
@@ -0,0 +1,369 @@
+#ifndef __JSON_PIPELINE_H__
+#define __JSON_PIPELINE_H__
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include "jsonParser.h"
+#include "BufList/bufList.hpp"
+
+// 流水线配置
+struct JsonPipelineConfig {
+    size_t worker_threads = 0;      // 处理线程数，0 取硬件线程数
+    size_t sink_threads = 1;        // 输出线程数
+    size_t batch_size = 64;         // 每批消息数，阶段之间按批传递
+    size_t queue_batches = 16;      // 每个队列最多缓存的批数，队列满时上游阻塞（背压）
+    size_t read_chunk = 64 * 1024;  // 从 fd 读取时每次读取的字节数
+    JsonParserFactory::ParserType parser_type = JsonParserFactory::ParserType::INCREMENTAL;
+    size_t parser_buffer_size = 8192;
+};
+
+// 单个阶段的统计快照
+struct JsonPipelineStageStats {
+    std::string name;
+    size_t threads = 0;
+    uint64_t items = 0;             // 处理的消息数
+    uint64_t batches = 0;           // 处理的批数
+    uint64_t busy_ns = 0;           // 所有线程累计处理时间（不含等待队列）
+    uint64_t batch_max_ns = 0;      // 单批最长处理时间
+    double elapsed_s = 0;           // 流水线运行时长
+    BufListStats input;             // 输入队列统计（源阶段无输入队列）
+
+    // 每秒处理的消息数
+    double throughput() const {
+        return elapsed_s > 0 ? items / elapsed_s : 0.0;
+    }
+
+    // 单批平均处理时间(ns)
+    double avg_batch_ns() const {
+        return batches ? static_cast<double>(busy_ns) / batches : 0.0;
+    }
+
+    // 线程忙碌比例，接近 1 的阶段即为瓶颈
+    double utilization() const {
+        return (elapsed_s > 0 && threads) ? busy_ns / (elapsed_s * 1e9 * threads) : 0.0;
+    }
+};
+
+/**
+ * @brief JSON 处理流水线：源 -> 分帧 -> N 个处理线程 -> 输出
+ *
+ * 源（内存、文件、fd）在调用线程中喂给分帧器，分帧出的消息凑满一批后移入有界队列；
+ * 处理线程逐条调用 handler，把结果按批移入输出队列；输出线程逐条调用 sink。
+ * 批在队列间整体移动，不逐条拷贝也不逐条加锁；队列满时上游阻塞，形成背压。
+ * 每条消息只从分帧缓冲区拷贝一次；用完的批经回收队列还给上游，稳态下不再分配批的存储。
+ * 多个处理线程时输出顺序与输入顺序不保证一致。
+ *
+ * 用法：
+ *   JsonPipeline<std::string> pipeline(config,
+ *       [](const std::string& json, std::string& out) { out = transform(json); return true; },
+ *       [](std::string& out) { write(out); });
+ *   pipeline.start();
+ *   pipeline.runFile("data.ndjson");
+ *   pipeline.close();
+ *   pipeline.printStats();
+ */
+template<typename Result = std::string>
+class JsonPipeline {
+    public:
+        // 返回 false 表示该消息没有输出
+        using Handler = std::function<bool(const std::string& json, Result& out)>;
+        using Sink = std::function<void(Result& out)>;
+        using ErrorCallback = JsonParserBase::ErrorCallback;
+
+        JsonPipeline(const JsonPipelineConfig& config, Handler handler, Sink sink, ErrorCallback error_callback = nullptr)
+            : _config(config),
+              _handler(std::move(handler)),
+              _sink(std::move(sink)),
+              _error_callback(std::move(error_callback)),
+              _work_queue(std::max<size_t>(1, config.queue_batches), "work"),
+              _sink_queue(std::max<size_t>(1, config.queue_batches), "sink"),
+              _free_batches(maxInFlight(config), "work_free"),
+              _free_results(maxInFlight(config), "sink_free") {
+            if (_config.worker_threads == 0) {
+                _config.worker_threads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            _config.sink_threads = std::max<size_t>(1, _config.sink_threads);
+            _config.batch_size = std::max<size_t>(1, _config.batch_size);
+            _parser = JsonParserFactory::createViewParser(_config.parser_type,
+                [this](const JsonFrame& frame) {
+                    _pending.emplace_back(frame.size(), '\0');
+                    if (!frame.empty()) frame.copyTo(&_pending.back()[0]);
+                    if (_pending.size() >= _config.batch_size) {
+                        flushPending();
+                    }
+                },
+                [this](const std::string& error) {
+                    reportError(error);
+                },
+                _config.parser_buffer_size);
+            _pending.reserve(_config.batch_size);
+        }
+
+        ~JsonPipeline() {
+            close();
+        }
+
+        // 禁止拷贝
+        JsonPipeline(const JsonPipeline&) = delete;
+        JsonPipeline& operator=(const JsonPipeline&) = delete;
+
+        // 启动处理线程和输出线程
+        void start() {
+            if (_started.load(std::memory_order_relaxed)) return;
+            _start_ns.store(nowNs(), std::memory_order_relaxed);
+            _started.store(true, std::memory_order_release);
+            for (size_t i = 0; i < _config.worker_threads; ++i) {
+                _workers.emplace_back(&JsonPipeline::workerLoop, this);
+            }
+            for (size_t i = 0; i < _config.sink_threads; ++i) {
+                _sinks.emplace_back(&JsonPipeline::sinkLoop, this);
+            }
+        }
+
+        // 源：喂入一段字节流，可多次调用；只能在一个线程中调用
+        void feed(const char* data, size_t len) {
+            Clock::time_point t0 = Clock::now();
+            _parser->addData(data, len);
+            addBusy(_source, t0);
+        }
+
+        void feed(const std::string& data) {
+            feed(data.data(), data.size());
+        }
+
+        // 源：映射整个文件并分帧
+        bool runFile(const std::string& path) {
+            Clock::time_point t0 = Clock::now();
+            bool ok = _parser->parseFile(path);
+            addBusy(_source, t0);
+            return ok;
+        }
+
+#if defined(JSON_PARSER_HAS_MMAP)
+        // 源：从 fd 读到 EOF，不关闭 fd；数据由内核直接读入分帧缓冲区
+        bool runFd(int fd) {
+            while (true) {
+                Clock::time_point t0 = Clock::now();
+                ssize_t n = _parser->readFrom(fd, _config.read_chunk);
+                addBusy(_source, t0);
+                if (n < 0) {
+                    reportError("读取失败: fd " + std::to_string(fd));
+                    return false;
+                }
+                if (n == 0) return true;
+            }
+        }
+#endif
+
+        // 结束输入并送出未满的批，关闭各队列并等待所有线程处理完毕；可重复调用
+        // 运行时长在所有线程结束后记录，之后才标记为已关闭
+        void close() {
+            if (_closing) return;
+            _closing = true;
+            if (!_started.load(std::memory_order_relaxed)) start();
+            _parser->finish();
+            flushPending();
+            _work_queue.close();
+            for (auto& t : _workers) t.join();
+            _sink_queue.close();
+            for (auto& t : _sinks) t.join();
+            _elapsed_ns.store(nowNs() - _start_ns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _closed.store(true, std::memory_order_release);
+        }
+
+        // 各阶段统计：source、worker、sink；可在任意线程中调用
+        std::vector<JsonPipelineStageStats> stats() const {
+            uint64_t elapsed_ns = 0;
+            if (_closed.load(std::memory_order_acquire)) {
+                elapsed_ns = _elapsed_ns.load(std::memory_order_relaxed);
+            } else if (_started.load(std::memory_order_acquire)) {
+                elapsed_ns = nowNs() - _start_ns.load(std::memory_order_relaxed);
+            }
+            double elapsed_s = elapsed_ns / 1e9;
+            std::vector<JsonPipelineStageStats> result;
+            BufListStats work = _work_queue.stats();
+            result.push_back(snapshot("source", 1, _source, elapsed_s));
+            // 源阶段的计时包含背压阻塞，扣除后才是分帧本身的耗时
+            result.back().busy_ns -= std::min(result.back().busy_ns, work.producer_blocked_ns);
+            result.push_back(snapshot("worker", _config.worker_threads, _worker, elapsed_s));
+            result.back().input = work;
+            result.push_back(snapshot("sink", _config.sink_threads, _sink_counters, elapsed_s));
+            result.back().input = _sink_queue.stats();
+            return result;
+        }
+
+        void printStats(std::ostream& os = std::cout) const {
+            for (const auto& st : stats()) {
+                os << "Stage[" << st.name << "] threads: " << st.threads << std::endl;
+                os << "  Items: " << st.items << " (" << st.throughput() << " msg/s), batches: " << st.batches << std::endl;
+                os << "  Batch latency: avg " << st.avg_batch_ns() / 1000.0 << " us, max "
+                   << st.batch_max_ns / 1000.0 << " us" << std::endl;
+                os << "  Utilization: " << st.utilization() * 100.0 << "%" << std::endl;
+                if (!st.input.name.empty()) {
+                    os << "  Input queue: avg wait " << st.input.avg_sojourn_ns() / 1000.0 << " us, high water "
+                       << st.input.high_water << "/" << st.input.max_size << std::endl;
+                }
+            }
+        }
+
+        const JsonPipelineConfig& config() const {
+            return _config;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Counters {
+            std::atomic<uint64_t> items{0};
+            std::atomic<uint64_t> batches{0};
+            std::atomic<uint64_t> busy_ns{0};
+            std::atomic<uint64_t> batch_max_ns{0};
+        };
+
+        // 同时在途的批数上限：队列容量 + 各线程手中的批，回收队列按此缓存
+        static size_t maxInFlight(const JsonPipelineConfig& config) {
+            size_t workers = config.worker_threads ? config.worker_threads : std::max(1u, std::thread::hardware_concurrency());
+            return std::max<size_t>(1, config.queue_batches) + workers + std::max<size_t>(1, config.sink_threads) + 1;
+        }
+
+        static uint64_t nowNs() {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+        }
+
+        static uint64_t elapsedNs(Clock::time_point start) {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+
+        static void addBusy(Counters& c, Clock::time_point start) {
+            c.busy_ns.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+        }
+
+        // 记录一批的处理时间
+        static void addBatch(Counters& c, size_t items, Clock::time_point start) {
+            uint64_t ns = elapsedNs(start);
+            c.items.fetch_add(items, std::memory_order_relaxed);
+            c.batches.fetch_add(1, std::memory_order_relaxed);
+            c.busy_ns.fetch_add(ns, std::memory_order_relaxed);
+            uint64_t prev = c.batch_max_ns.load(std::memory_order_relaxed);
+            while (ns > prev && !c.batch_max_ns.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {}
+        }
+
+        static JsonPipelineStageStats snapshot(const char* name, size_t threads, const Counters& c, double elapsed_s) {
+            JsonPipelineStageStats st;
+            st.name = name;
+            st.threads = threads;
+            st.items = c.items.load(std::memory_order_relaxed);
+            st.batches = c.batches.load(std::memory_order_relaxed);
+            st.busy_ns = c.busy_ns.load(std::memory_order_relaxed);
+            st.batch_max_ns = c.batch_max_ns.load(std::memory_order_relaxed);
+            st.elapsed_s = elapsed_s;
+            return st;
+        }
+
+        // 源线程中调用：把当前批移入处理队列，队列满时阻塞；下一批优先取回收的存储
+        void flushPending() {
+            if (_pending.empty()) return;
+            _source.items.fetch_add(_pending.size(), std::memory_order_relaxed);
+            _source.batches.fetch_add(1, std::memory_order_relaxed);
+            if (!_started.load(std::memory_order_relaxed)) start();
+            _work_queue.write(std::move(_pending), -1);
+            if (!_free_batches.read(_pending)) {
+                _pending = std::vector<std::string>();
+                _pending.reserve(_config.batch_size);
+            }
+        }
+
+        void workerLoop() {
+            std::vector<std::string> batch;
+            std::vector<Result> results;
+            while (_work_queue.read(batch, -1)) {
+                Clock::time_point t0 = Clock::now();
+                if (results.capacity() == 0 && !_free_results.read(results)) {
+                    results.reserve(_config.batch_size);
+                }
+                for (const auto& json : batch) {
+                    Result out;
+                    try {
+                        if (_handler(json, out)) {
+                            results.push_back(std::move(out));
+                        }
+                    } catch (const std::exception& e) {
+                        reportError(e.what());
+                    }
+                }
+                addBatch(_worker, batch.size(), t0);
+                batch.clear();
+                _free_batches.write(std::move(batch));
+                if (!results.empty()) {
+                    _sink_queue.write(std::move(results), -1);
+                    results = std::vector<Result>();
+                }
+            }
+        }
+
+        void sinkLoop() {
+            std::vector<Result> batch;
+            while (_sink_queue.read(batch, -1)) {
+                Clock::time_point t0 = Clock::now();
+                for (auto& out : batch) {
+                    try {
+                        _sink(out);
+                    } catch (const std::exception& e) {
+                        reportError(e.what());
+                    }
+                }
+                addBatch(_sink_counters, batch.size(), t0);
+                batch.clear();
+                _free_results.write(std::move(batch));
+            }
+        }
+
+        // 源、处理和输出线程都可能报错，串行化错误回调
+        void reportError(const std::string& message) {
+            std::lock_guard<std::mutex> lock(_error_mutex);
+            if (_error_callback) {
+                _error_callback(message);
+            } else {
+                std::cerr << "JSON解析错误: " << message << std::endl;
+            }
+        }
+
+        JsonPipelineConfig _config;
+        Handler _handler;
+        Sink _sink;
+        ErrorCallback _error_callback;     // 可能在多个线程中被调用，持 _error_mutex 执行
+        std::mutex _error_mutex;
+
+        std::unique_ptr<JsonParserBase> _parser;
+        std::vector<std::string> _pending;  // 源线程正在凑的批
+        BufList<std::vector<std::string>> _work_queue;
+        BufList<std::vector<Result>> _sink_queue;
+        // 用完的批回收给上游复用，满时直接丢弃；非阻塞读写
+        BufList<std::vector<std::string>> _free_batches;
+        BufList<std::vector<Result>> _free_results;
+        std::vector<std::thread> _workers;
+        std::vector<std::thread> _sinks;
+
+        // stats() 可在任意线程中读取运行状态
+        std::atomic<bool> _started{false};
+        std::atomic<bool> _closed{false};
+        bool _closing = false;                  // close() 的重入保护，只在控制线程中访问
+        std::atomic<uint64_t> _start_ns{0};
+        std::atomic<uint64_t> _elapsed_ns{0};
+        Counters _source;
+        Counters _worker;
+        Counters _sink_counters;
+};
+
+#endif // __JSON_PIPELINE_H__
@@ -0,0 +1,218 @@
+#ifndef __JSON_QUERY_H__
+#define __JSON_QUERY_H__
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include "jsonParser.h"
+#include "jsonNumber.h"
+
+/**
+ * @brief 按需取值：在一条已分帧的 JSON 上按 JSON Pointer（RFC 6901）定位字段
+ *
+ * 只沿路径逐层前进：路径外的对象和数组交给 JsonStateTtacker::scan() 用结构字符位图整体跳过，
+ * 字符串只找结束引号，不建树、不反转义、不解析数字。
+ * 返回值是原始字节的视图（字符串含引号），找不到或格式错误时返回空视图。
+ * 只校验经过的部分，不保证整条消息是合法 JSON。
+ *
+ * 用法：
+ *   JsonView type = JsonQuery::get(msg, "/header/type");     // "\"trade\""
+ *   std::string name;
+ *   if (JsonQuery::getString(msg, "/user/name", name)) ...
+ */
+class JsonQuery {
+    public:
+        // pointer 为空串表示整条消息，否则以 '/' 开头；"~0" 表示 '~'，"~1" 表示 '/'
+        static JsonView get(const JsonView& msg, const char* pointer) {
+            return get(msg, pointer, std::strlen(pointer));
+        }
+
+        static JsonView get(const JsonView& msg, const std::string& pointer) {
+            return get(msg, pointer.data(), pointer.size());
+        }
+
+        static JsonView get(const JsonView& msg, const char* pointer, size_t pointer_len) {
+            const char* p = msg.data;
+            const char* end = msg.data + msg.size;
+            const char* ptr = pointer;
+            const char* ptr_end = pointer + pointer_len;
+            if (ptr != ptr_end && *ptr != '/') return JsonView();
+
+            skipWhitespace(p, end);
+            std::string decoded;
+            std::string scratch;
+            while (ptr < ptr_end) {
+                // 取出下一段引用 token，含 ~0/~1 时每层只解码一次
+                const char* token = ++ptr;
+                while (ptr < ptr_end && *ptr != '/') ++ptr;
+                JsonView ref(token, ptr - token);
+                if (std::memchr(ref.data, '~', ref.size)) {
+                    decodeToken(ref, decoded);
+                    ref = JsonView(decoded.data(), decoded.size());
+                }
+
+                if (p >= end) return JsonView();
+                bool found = false;
+                if (*p == '{') {
+                    found = findMember(p, end, ref, scratch);
+                } else if (*p == '[') {
+                    found = findElement(p, end, ref);
+                }
+                if (!found) return JsonView();
+            }
+
+            const char* value_begin = p;
+            if (!skipValue(p, end)) return JsonView();
+            return JsonView(value_begin, p - value_begin);
+        }
+
+        // 环形缓冲区中回绕的帧先拼接到 scratch
+        static JsonView get(const JsonFrame& frame, const char* pointer, std::string& scratch) {
+            if (frame.contiguous()) {
+                return get(frame.first, pointer);
+            }
+            scratch.resize(frame.size());
+            frame.copyTo(&scratch[0]);
+            return get(JsonView(scratch.data(), scratch.size()), pointer);
+        }
+
+        // 取字符串字段的内容（去掉引号并反转义），字段不存在或不是字符串时返回 false
+        static bool getString(const JsonView& msg, const char* pointer, std::string& out) {
+            JsonView raw = get(msg, pointer);
+            if (raw.size < 2 || raw.data[0] != '"') return false;
+            out.clear();
+            jsonUnescape(JsonView(raw.data + 1, raw.size - 2), out);
+            return true;
+        }
+
+        // 取数字字段，字段不存在或不是数字时返回 false
+        static bool getNumber(const JsonView& msg, const char* pointer, JsonNumber& out) {
+            JsonView raw = get(msg, pointer);
+            return !raw.empty() && JsonNumberParser::parse(raw.data, raw.size, out);
+        }
+
+        // 字段是否存在
+        static bool contains(const JsonView& msg, const char* pointer) {
+            return !get(msg, pointer).empty();
+        }
+
+    private:
+        static void skipWhitespace(const char*& p, const char* end) {
+            while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) ++p;
+        }
+
+        // 跳过一个完整的值，p 停在值之后
+        static bool skipValue(const char*& p, const char* end) {
+            if (p >= end) return false;
+            switch (*p) {
+                case '{':
+                case '[': {
+                    JsonStateTtacker tracker;
+                    size_t n = tracker.scan(p, end - p);
+                    if (!tracker.isComplete()) return false;
+                    p += n;
+                    return true;
+                }
+                case '"':
+                    return skipString(p, end);
+                default: {
+                    const char* start = p;
+                    while (p < end && *p != ',' && *p != '}' && *p != ']' &&
+                           *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') {
+                        ++p;
+                    }
+                    return p != start;
+                }
+            }
+        }
+
+        // p 指向起始引号，跳过整个字符串
+        static bool skipString(const char*& p, const char* end) {
+            const char* q = p + 1;
+            while (q < end) {
+                const char* quote = static_cast<const char*>(std::memchr(q, '"', end - q));
+                if (!quote) return false;
+                // 引号前连续反斜杠为偶数个时才是结束引号
+                const char* bs = quote;
+                while (bs > q && bs[-1] == '\\') --bs;
+                if (((quote - bs) & 1) == 0) {
+                    p = quote + 1;
+                    return true;
+                }
+                q = quote + 1;
+            }
+            return false;
+        }
+
+        // 比较键（引号内原始字节）与已解码的引用 token，键含转义时先反转义到 scratch
+        static bool keyEquals(const JsonView& key, const JsonView& ref, std::string& scratch) {
+            if (std::memchr(key.data, '\\', key.size) == nullptr) {
+                return key.size == ref.size && std::memcmp(key.data, ref.data, key.size) == 0;
+            }
+            scratch.clear();
+            jsonUnescape(key, scratch);
+            return scratch.size() == ref.size && std::memcmp(scratch.data(), ref.data, ref.size) == 0;
+        }
+
+        static void decodeToken(const JsonView& ref, std::string& out) {
+            out.clear();
+            for (size_t i = 0; i < ref.size; ++i) {
+                if (ref.data[i] == '~' && i + 1 < ref.size && (ref.data[i + 1] == '0' || ref.data[i + 1] == '1')) {
+                    out.push_back(ref.data[i + 1] == '0' ? '~' : '/');
+                    ++i;
+                } else {
+                    out.push_back(ref.data[i]);
+                }
+            }
+        }
+
+        // p 指向 '{'，找到成员时 p 指向成员值
+        static bool findMember(const char*& p, const char* end, const JsonView& ref, std::string& scratch) {
+            ++p;
+            skipWhitespace(p, end);
+            if (p < end && *p == '}') return false;
+            while (p < end) {
+                if (*p != '"') return false;
+                const char* key_begin = p + 1;
+                if (!skipString(p, end)) return false;
+                JsonView key(key_begin, p - 1 - key_begin);
+                skipWhitespace(p, end);
+                if (p >= end || *p != ':') return false;
+                ++p;
+                skipWhitespace(p, end);
+                if (keyEquals(key, ref, scratch)) return p < end;
+                if (!skipValue(p, end)) return false;
+                skipWhitespace(p, end);
+                if (p >= end || *p != ',') return false;
+                ++p;
+                skipWhitespace(p, end);
+            }
+            return false;
+        }
+
+        // p 指向 '['，token 为十进制下标，找到时 p 指向元素
+        // 超过 19 位的下标一定越界，直接拒绝以免 size_t 溢出回绕
+        static bool findElement(const char*& p, const char* end, const JsonView& ref) {
+            if (ref.size == 0 || ref.size > 19 || (ref.size > 1 && ref.data[0] == '0')) return false;
+            size_t index = 0;
+            for (size_t i = 0; i < ref.size; ++i) {
+                if (ref.data[i] < '0' || ref.data[i] > '9') return false;
+                index = index * 10 + (ref.data[i] - '0');
+            }
+            ++p;
+            skipWhitespace(p, end);
+            if (p < end && *p == ']') return false;
+            while (p < end) {
+                if (index == 0) return true;
+                if (!skipValue(p, end)) return false;
+                skipWhitespace(p, end);
+                if (p >= end || *p != ',') return false;
+                ++p;
+                skipWhitespace(p, end);
+                --index;
+            }
+            return false;
+        }
+};
+
+#endif // __JSON_QUERY_H__
@@ -0,0 +1,420 @@
+#ifndef __JSON_SAX_H__
+#define __JSON_SAX_H__
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include "jsonParser.h"
+#include "jsonNumber.h"
+
+/**
+ * @brief SAX 事件处理器
+ *
+ * 字符串、键和数字以 JsonView 传入，仅在回调期间有效；字符串已反转义。
+ * 任一回调返回 false 时中止当前消息的解析并上报错误。
+ */
+class JsonSaxHandler {
+    public:
+        virtual ~JsonSaxHandler() = default;
+
+        virtual bool startObject() { return true; }
+        virtual bool endObject() { return true; }
+        virtual bool startArray() { return true; }
+        virtual bool endArray() { return true; }
+        virtual bool key(const JsonView& /*name*/) { return true; }
+        virtual bool string(const JsonView& /*value*/) { return true; }
+        // 数字的原始文本，已校验语法；默认实现转换后分派到下面三个按类型的回调
+        virtual bool number(const JsonView& raw) {
+            JsonNumber value;
+            JsonNumberParser::parse(raw.data, raw.size, value);
+            switch (value.type) {
+                case JsonNumberType::Int64: return int64Value(value.i);
+                case JsonNumberType::UInt64: return uint64Value(value.u);
+                default: return doubleValue(value.d);
+            }
+        }
+        virtual bool int64Value(int64_t /*value*/) { return true; }
+        virtual bool uint64Value(uint64_t /*value*/) { return true; }
+        virtual bool doubleValue(double /*value*/) { return true; }
+        virtual bool boolean(bool /*value*/) { return true; }
+        virtual bool nullValue() { return true; }
+        // 一条顶层JSON结束
+        virtual void endDocument() {}
+};
+
+/**
+ * @brief 增量 SAX 解析器
+ *
+ * 直接在 addData() 传入的字节上边扫描边产生事件，不组装完整消息，也不建树；
+ * 解析状态（容器栈、未结束的字符串/数字/字面量）跨 addData() 调用保留。
+ * 未跨块且不含转义的字符串与数字直接以输入缓冲区的视图回调；
+ * 跨块或含转义的才复制到内部暂存区，暂存区和容器栈的容量在消息间复用，
+ * 稳态下解析不做任何内存分配。
+ *
+ * 出错时调用 ErrorCallback，丢弃当前数据块剩余部分并从下一次 addData() 重新开始。
+ */
+class JsonSaxParser {
+    public:
+        using ErrorCallback = JsonParserBase::ErrorCallback;
+
+        explicit JsonSaxParser(JsonSaxHandler& handler, ErrorCallback error_callback = nullptr, size_t max_depth = 512)
+            : _handler(handler), _error_callback(std::move(error_callback)), _max_depth(max_depth) {
+            _stack.reserve(max_depth < 64 ? max_depth : 64);
+        }
+
+        void addData(const std::string& data) {
+            addData(data.data(), data.size());
+        }
+
+        void addData(const char* data, size_t len) {
+            const char* p = data;
+            const char* end = data + len;
+            while (p < end) {
+                if (!step(p, end)) {
+                    reportError();
+                    clear();
+                    return;
+                }
+            }
+            // 数据块结束时还未结束的字符串或数字，把本块中已扫描的部分存入暂存区
+            if (_state == STRING || _state == NUMBER) {
+                if (_partial) {
+                    _token.append(_token_start, end - _token_start);
+                } else {
+                    _token.assign(_token_start, end - _token_start);
+                    _partial = true;
+                }
+            }
+        }
+
+        // 输入结束：输出末尾未以分隔符结束的顶层数字（如 "42"），
+        // 此后仍有未完成的消息时上报错误并丢弃，语义同 JsonParserBase::finish()
+        void finish() {
+            if (_state == NUMBER && _stack.empty() && _partial) {
+                _partial = false;
+                if (!emitNumber(JsonView(_token.data(), _token.size()))) {
+                    reportError();
+                    clear();
+                    return;
+                }
+            }
+            if (inDocument()) {
+                fail("输入结束时消息不完整");
+                reportError();
+            }
+            clear();
+        }
+
+        // 丢弃未完成的消息
+        void clear() {
+            _stack.clear();
+            _state = VALUE;
+            _partial = false;
+            _token.clear();
+            _error = nullptr;
+        }
+
+        // 是否处于一条消息的中间
+        bool inDocument() const {
+            return !_stack.empty() || (_state != VALUE);
+        }
+
+        size_t depth() const {
+            return _stack.size();
+        }
+
+    private:
+        enum State : uint8_t {
+            VALUE,          // 期待一个值
+            FIRST_VALUE,    // '[' 之后，期待值或 ']'
+            FIRST_KEY,      // '{' 之后，期待键或 '}'
+            KEY,            // 对象中 ',' 之后，期待键
+            COLON,          // 键之后，期待 ':'
+            AFTER_VALUE,    // 容器中的值之后，期待 ',' 或结束括号
+            STRING,         // 字符串中
+            NUMBER,         // 数字中
+            LITERAL         // true/false/null 中
+        };
+
+        static bool isSpace(char c) {
+            return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        }
+
+        static bool isHex(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        }
+
+        static bool isNumberChar(char c) {
+            return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+        }
+
+        // 校验数字语法：-?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)?
+        static bool validNumber(const char* p, size_t len) {
+            const char* end = p + len;
+            if (p < end && *p == '-') ++p;
+            if (p >= end) return false;
+            if (*p == '0') {
+                ++p;
+            } else if (*p >= '1' && *p <= '9') {
+                while (p < end && *p >= '0' && *p <= '9') ++p;
+            } else {
+                return false;
+            }
+            if (p < end && *p == '.') {
+                ++p;
+                if (p >= end || *p < '0' || *p > '9') return false;
+                while (p < end && *p >= '0' && *p <= '9') ++p;
+            }
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                ++p;
+                if (p < end && (*p == '+' || *p == '-')) ++p;
+                if (p >= end || *p < '0' || *p > '9') return false;
+                while (p < end && *p >= '0' && *p <= '9') ++p;
+            }
+            return p == end;
+        }
+
+        bool fail(const char* message) {
+            _error = message;
+            return false;
+        }
+
+        void reportError() {
+            std::string message = std::string("SAX解析错误: ") + (_error ? _error : "未知错误");
+            if (_error_callback) {
+                _error_callback(message);
+            } else {
+                std::cerr << message << std::endl;
+            }
+        }
+
+        // 处理一个状态转移，p 前移；返回 false 表示出错
+        bool step(const char*& p, const char* end) {
+            switch (_state) {
+                case STRING:
+                    return scanString(p, end);
+                case NUMBER:
+                    return scanNumber(p, end);
+                case LITERAL:
+                    return scanLiteral(p, end);
+                default:
+                    break;
+            }
+
+            while (p < end && isSpace(*p)) ++p;
+            if (p >= end) return true;
+            const char c = *p;
+
+            switch (_state) {
+                case FIRST_VALUE:
+                    if (c == ']') {
+                        ++p;
+                        return closeContainer('[');
+                    }
+                    return beginValue(p);
+                case VALUE:
+                    return beginValue(p);
+                case FIRST_KEY:
+                    if (c == '}') {
+                        ++p;
+                        return closeContainer('{');
+                    }
+                    // fall through
+                case KEY:
+                    if (c != '"') return fail("对象的键必须是字符串");
+                    beginString(++p, true);
+                    return true;
+                case COLON:
+                    if (c != ':') return fail("对象中缺少':'");
+                    ++p;
+                    _state = VALUE;
+                    return true;
+                case AFTER_VALUE:
+                    ++p;
+                    if (c == ',') {
+                        _state = _stack.back() == '{' ? KEY : VALUE;
+                        return true;
+                    }
+                    if (c == '}' || c == ']') {
+                        return closeContainer(c == '}' ? '{' : '[');
+                    }
+                    return fail("缺少','或结束括号");
+                default:
+                    return fail("内部状态错误");
+            }
+        }
+
+        bool beginValue(const char*& p) {
+            const char c = *p;
+            switch (c) {
+                case '{':
+                case '[':
+                    if (_stack.size() >= _max_depth) return fail("嵌套层数超出限制");
+                    ++p;
+                    _stack.push_back(c);
+                    _state = c == '{' ? FIRST_KEY : FIRST_VALUE;
+                    return c == '{' ? _handler.startObject() || fail("处理器中止")
+                                    : _handler.startArray() || fail("处理器中止");
+                case '"':
+                    beginString(++p, false);
+                    return true;
+                case 't':
+                    _literal = "true";
+                    break;
+                case 'f':
+                    _literal = "false";
+                    break;
+                case 'n':
+                    _literal = "null";
+                    break;
+                default:
+                    if (c == '-' || (c >= '0' && c <= '9')) {
+                        _state = NUMBER;
+                        _partial = false;
+                        _token_start = p;
+                        return true;
+                    }
+                    return fail("无效的值");
+            }
+            _literal_pos = 0;
+            _state = LITERAL;
+            return true;
+        }
+
+        void beginString(const char* p, bool is_key) {
+            _state = STRING;
+            _string_is_key = is_key;
+            _partial = false;
+            _has_escape = false;
+            _after_backslash = false;
+            _hex_left = 0;
+            _token_start = p;
+        }
+
+        bool scanString(const char*& p, const char* end) {
+            // 续接上一个数据块时从本块开头计
+            if (_partial) _token_start = p;
+            while (p < end) {
+                const unsigned char c = static_cast<unsigned char>(*p);
+                if (_hex_left) {
+                    if (!isHex(c)) return fail("无效的\\u转义");
+                    --_hex_left;
+                } else if (_after_backslash) {
+                    _after_backslash = false;
+                    if (c == 'u') {
+                        _hex_left = 4;
+                    } else if (c != '"' && c != '\\' && c != '/' && c != 'b' && c != 'f' && c != 'n' && c != 'r' && c != 't') {
+                        return fail("无效的转义字符");
+                    }
+                } else if (c == '\\') {
+                    _after_backslash = true;
+                    _has_escape = true;
+                } else if (c == '"') {
+                    JsonView raw;
+                    if (_partial) {
+                        _token.append(_token_start, p - _token_start);
+                        raw = JsonView(_token.data(), _token.size());
+                    } else {
+                        raw = JsonView(_token_start, p - _token_start);
+                    }
+                    ++p;
+                    _partial = false;
+                    return emitString(raw);
+                } else if (c < 0x20) {
+                    return fail("字符串中含未转义的控制字符");
+                }
+                ++p;
+            }
+            // 数据块结束，由 addData() 保存未完成的部分
+            return true;
+        }
+
+        bool emitString(const JsonView& raw) {
+            JsonView value = raw;
+            if (_has_escape) {
+                _unescaped.clear();
+                jsonUnescape(raw, _unescaped);
+                value = JsonView(_unescaped.data(), _unescaped.size());
+            }
+            if (_string_is_key) {
+                _state = COLON;
+                return _handler.key(value) || fail("处理器中止");
+            }
+            return (_handler.string(value) || fail("处理器中止")) && completeValue();
+        }
+
+        bool scanNumber(const char*& p, const char* end) {
+            if (_partial) _token_start = p;
+            while (p < end && isNumberChar(*p)) ++p;
+            if (p >= end) return true;   // 可能跨块，由 addData() 保存
+
+            JsonView raw;
+            if (_partial) {
+                _token.append(_token_start, p - _token_start);
+                raw = JsonView(_token.data(), _token.size());
+            } else {
+                raw = JsonView(_token_start, p - _token_start);
+            }
+            _partial = false;
+            return emitNumber(raw);
+        }
+
+        bool emitNumber(const JsonView& raw) {
+            if (!validNumber(raw.data, raw.size)) return fail("无效的数字");
+            return (_handler.number(raw) || fail("处理器中止")) && completeValue();
+        }
+
+        bool scanLiteral(const char*& p, const char* end) {
+            while (p < end && _literal[_literal_pos]) {
+                if (*p != _literal[_literal_pos]) return fail("无效的字面量");
+                ++p;
+                ++_literal_pos;
+            }
+            if (_literal[_literal_pos]) return true;   // 跨块，继续等待
+            bool ok = _literal[0] == 'n' ? _handler.nullValue() : _handler.boolean(_literal[0] == 't');
+            return (ok || fail("处理器中止")) && completeValue();
+        }
+
+        bool closeContainer(char open) {
+            if (_stack.empty() || _stack.back() != open) return fail("括号不匹配");
+            _stack.pop_back();
+            bool ok = open == '{' ? _handler.endObject() : _handler.endArray();
+            return (ok || fail("处理器中止")) && completeValue();
+        }
+
+        // 一个值结束：回到外层容器，或结束整条消息
+        bool completeValue() {
+            if (_stack.empty()) {
+                _state = VALUE;
+                _handler.endDocument();
+            } else {
+                _state = AFTER_VALUE;
+            }
+            return true;
+        }
+
+        JsonSaxHandler& _handler;
+        ErrorCallback _error_callback;
+        size_t _max_depth;
+
+        std::vector<char> _stack;          // 容器栈：'{' 或 '['
+        State _state = VALUE;
+        const char* _error = nullptr;
+
+        // 字符串/数字的扫描状态
+        const char* _token_start = nullptr; // 当前数据块中 token 的起始位置
+        bool _partial = false;              // token 跨块，前半部分在 _token 中
+        bool _string_is_key = false;
+        bool _has_escape = false;
+        bool _after_backslash = false;
+        int _hex_left = 0;                  // \u 之后还需的十六进制位数
+        std::string _token;                 // 跨块 token 的暂存区
+        std::string _unescaped;             // 反转义结果的暂存区
+
+        // 字面量的扫描状态
+        const char* _literal = nullptr;
+        size_t _literal_pos = 0;
+};
+
+#endif // __JSON_SAX_H__
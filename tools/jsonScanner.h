@@ -0,0 +1,176 @@
+#ifndef __JSON_SCANNER_H__
+#define __JSON_SCANNER_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// 编译期选择实现：-mavx2 启用 AVX2，x86-64 默认 SSE2，其余平台走标量实现
+// 定义 JSON_SCANNER_NO_SIMD 可强制使用标量实现
+#if !defined(JSON_SCANNER_NO_SIMD) && defined(__AVX2__)
+#define JSON_SCANNER_AVX2 1
+#include <immintrin.h>
+#elif !defined(JSON_SCANNER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define JSON_SCANNER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// 携带 -mpclmul（或 -march=native）编译时，前缀异或使用无进位乘法
+#if !defined(JSON_SCANNER_NO_SIMD) && defined(__PCLMUL__)
+#define JSON_SCANNER_CLMUL 1
+#include <wmmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 64字节块中各类结构字符的位图，第 i 位对应块内第 i 个字节
+struct JsonBlockMasks {
+    uint64_t quote = 0;       // '"'
+    uint64_t backslash = 0;   // '\\'
+    uint64_t open = 0;        // '{' 或 '['
+    uint64_t close = 0;       // '}' 或 ']'
+};
+
+/**
+ * @brief JSON 结构字符扫描器（simdjson stage 1 风格）
+ *
+ * 每次处理 64 字节，一次比较得到引号、反斜杠、左右括号的位图，
+ * 上层只需遍历位图中的置位，而不必逐字节分支判断。
+ * '{' 与 '['、'}' 与 ']' 只差 0x20 位，或上 0x20 后一次比较即可同时命中。
+ */
+class JsonStructuralScanner {
+    public:
+        enum { BLOCK_SIZE = 64 };
+
+        // 扫描完整的64字节块
+        static void scanBlock(const char* p, JsonBlockMasks& masks) {
+#if defined(JSON_SCANNER_AVX2)
+            const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32));
+            const __m256i case_bit = _mm256_set1_epi8(0x20);
+            const __m256i lo_fold = _mm256_or_si256(lo, case_bit);
+            const __m256i hi_fold = _mm256_or_si256(hi, case_bit);
+            masks.quote = eq256(lo, hi, '"');
+            masks.backslash = eq256(lo, hi, '\\');
+            masks.open = eq256(lo_fold, hi_fold, '{');
+            masks.close = eq256(lo_fold, hi_fold, '}');
+#elif defined(JSON_SCANNER_SSE2)
+            __m128i v[4];
+            __m128i fold[4];
+            const __m128i case_bit = _mm_set1_epi8(0x20);
+            for (int i = 0; i < 4; ++i) {
+                v[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 16));
+                fold[i] = _mm_or_si128(v[i], case_bit);
+            }
+            masks.quote = eq128(v, '"');
+            masks.backslash = eq128(v, '\\');
+            masks.open = eq128(fold, '{');
+            masks.close = eq128(fold, '}');
+#else
+            uint64_t quote = 0, backslash = 0, open = 0, close = 0;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                const uint64_t bit = uint64_t(1) << i;
+                switch (p[i]) {
+                    case '"':  quote |= bit; break;
+                    case '\\': backslash |= bit; break;
+                    case '{':
+                    case '[':  open |= bit; break;
+                    case '}':
+                    case ']':  close |= bit; break;
+                    default: break;
+                }
+            }
+            masks.quote = quote;
+            masks.backslash = backslash;
+            masks.open = open;
+            masks.close = close;
+#endif
+        }
+
+        // 扫描不足64字节的尾部，超出 len 的部分按空白处理
+        static void scanTail(const char* p, size_t len, JsonBlockMasks& masks) {
+            char block[BLOCK_SIZE];
+            std::memset(block, ' ', sizeof(block));
+            std::memcpy(block, p, len);
+            scanBlock(block, masks);
+        }
+
+        // 前缀异或：结果第 i 位为 x 第 0~i 位的异或
+        // 对未转义引号位图求前缀异或即得字符串区间（含起始引号，不含结束引号）
+        static uint64_t prefixXor(uint64_t x) {
+#if defined(JSON_SCANNER_CLMUL)
+            const __m128i all_ones = _mm_set1_epi8(static_cast<char>(0xFF));
+            const __m128i result = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(x)), all_ones, 0);
+            return static_cast<uint64_t>(_mm_cvtsi128_si64(result));
+#else
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+#endif
+        }
+
+        // 求被反斜杠转义的字符位图：前面紧邻奇数个连续反斜杠的字符
+        // carry 为输入/输出参数，表示本块第一个字符是否被上一块末尾的反斜杠转义
+        static uint64_t findEscaped(uint64_t backslash, uint64_t& carry) {
+            const uint64_t even_bits = 0x5555555555555555ULL;
+            // 自身被转义的反斜杠不再转义后一个字符
+            backslash &= ~carry;
+            const uint64_t follows_escape = (backslash << 1) | carry;
+            // 从奇数位开始的反斜杠序列，加上整段序列后进位落在序列之后
+            const uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+            const uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+            carry = sequences_starting_on_even_bits < odd_sequence_starts ? 1 : 0;
+            const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+            return (even_bits ^ invert_mask) & follows_escape;
+        }
+
+        // 返回最低置位的下标，x 不能为 0
+        static int trailingZeros(uint64_t x) {
+#if defined(_MSC_VER)
+            unsigned long idx = 0;
+            _BitScanForward64(&idx, x);
+            return static_cast<int>(idx);
+#else
+            return __builtin_ctzll(x);
+#endif
+        }
+
+        // 当前编译使用的实现名称
+        static const char* implementation() {
+#if defined(JSON_SCANNER_AVX2)
+            return "avx2";
+#elif defined(JSON_SCANNER_SSE2)
+            return "sse2";
+#else
+            return "scalar";
+#endif
+        }
+
+    private:
+#if defined(JSON_SCANNER_AVX2)
+        static uint64_t eq256(__m256i lo, __m256i hi, char c) {
+            const __m256i needle = _mm256_set1_epi8(c);
+            const uint32_t lo_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+            const uint32_t hi_bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+            return uint64_t(lo_bits) | (uint64_t(hi_bits) << 32);
+        }
+#elif defined(JSON_SCANNER_SSE2)
+        static uint64_t eq128(const __m128i* v, char c) {
+            const __m128i needle = _mm_set1_epi8(c);
+            uint64_t bits = 0;
+            for (int i = 0; i < 4; ++i) {
+                const uint32_t m = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v[i], needle)));
+                bits |= uint64_t(m) << (i * 16);
+            }
+            return bits;
+        }
+#endif
+};
+
+#endif // __JSON_SCANNER_H__
@@ -0,0 +1,648 @@
+#ifndef __JSON_WRITER_H__
+#define __JSON_WRITER_H__
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include "jsonParser.h"
+
+/**
+ * @brief 整数与浮点数的快速格式化
+ *
+ * 整数按两位一组查表输出；浮点数用 Grisu2（Florian Loitsch 2010）生成能精确往返的最短数字，
+ * 输出格式与 JSON 兼容：整数值的浮点数带 ".0"，指数形式如 1.5e-7。
+ */
+class JsonNumberFormatter {
+    public:
+        // 写入 buf，返回写入的字节数；buf 至少 20 字节
+        static size_t formatUInt64(uint64_t value, char* buf) {
+            char tmp[20];
+            char* p = tmp + sizeof(tmp);
+            while (value >= 100) {
+                const unsigned idx = static_cast<unsigned>(value % 100) * 2;
+                value /= 100;
+                p -= 2;
+                p[0] = digitPairs()[idx];
+                p[1] = digitPairs()[idx + 1];
+            }
+            if (value >= 10) {
+                const unsigned idx = static_cast<unsigned>(value) * 2;
+                p -= 2;
+                p[0] = digitPairs()[idx];
+                p[1] = digitPairs()[idx + 1];
+            } else {
+                *--p = static_cast<char>('0' + value);
+            }
+            const size_t len = static_cast<size_t>(tmp + sizeof(tmp) - p);
+            std::memcpy(buf, p, len);
+            return len;
+        }
+
+        // buf 至少 21 字节
+        static size_t formatInt64(int64_t value, char* buf) {
+            if (value < 0) {
+                buf[0] = '-';
+                return 1 + formatUInt64(0 - static_cast<uint64_t>(value), buf + 1);
+            }
+            return formatUInt64(static_cast<uint64_t>(value), buf);
+        }
+
+        // buf 至少 32 字节；NaN 和无穷不是合法的 JSON 数字，输出 null
+        static size_t formatDouble(double value, char* buf) {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            if ((bits & kExponentMask) == kExponentMask) {
+                std::memcpy(buf, "null", 4);
+                return 4;
+            }
+            char* p = buf;
+            if (bits & kSignMask) {
+                *p++ = '-';
+                value = -value;
+            }
+            if ((bits & ~kSignMask) == 0) {
+                std::memcpy(p, "0.0", 3);
+                return static_cast<size_t>(p + 3 - buf);
+            }
+            int length = 0;
+            int k = 0;
+            grisu2(value, p, length, k);
+            return static_cast<size_t>(prettify(p, length, k) - buf);
+        }
+
+    private:
+        static const char* digitPairs() {
+            static const char pairs[] =
+                "00010203040506070809"
+                "10111213141516171819"
+                "20212223242526272829"
+                "30313233343536373839"
+                "40414243444546474849"
+                "50515253545556575859"
+                "60616263646566676869"
+                "70717273747576777879"
+                "80818283848586878889"
+                "90919293949596979899";
+            return pairs;
+        }
+
+        static const uint64_t kSignMask = 0x8000000000000000ULL;
+        static const uint64_t kExponentMask = 0x7FF0000000000000ULL;
+        static const uint64_t kSignificandMask = 0x000FFFFFFFFFFFFFULL;
+        static const uint64_t kHiddenBit = 0x0010000000000000ULL;
+
+        // 自定义浮点数 f * 2^e
+        struct DiyFp {
+            uint64_t f;
+            int e;
+
+            DiyFp() : f(0), e(0) {}
+            DiyFp(uint64_t fp, int exp) : f(fp), e(exp) {}
+
+            explicit DiyFp(double d) {
+                uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                const int biased_e = static_cast<int>((bits & kExponentMask) >> 52);
+                const uint64_t significand = bits & kSignificandMask;
+                if (biased_e != 0) {
+                    f = significand + kHiddenBit;
+                    e = biased_e - kExponentBias;
+                } else {
+                    f = significand;
+                    e = 1 - kExponentBias;
+                }
+            }
+
+            DiyFp operator-(const DiyFp& rhs) const {
+                return DiyFp(f - rhs.f, e);
+            }
+
+            // 128位乘积取高64位并四舍五入
+            DiyFp operator*(const DiyFp& rhs) const {
+#if defined(_MSC_VER)
+                uint64_t h = 0;
+                const uint64_t l = _umul128(f, rhs.f, &h);
+#else
+                const unsigned __int128 p = static_cast<unsigned __int128>(f) * rhs.f;
+                uint64_t h = static_cast<uint64_t>(p >> 64);
+                const uint64_t l = static_cast<uint64_t>(p);
+#endif
+                if (l & (uint64_t(1) << 63)) ++h;
+                return DiyFp(h, e + rhs.e + 64);
+            }
+
+            DiyFp normalize() const {
+#if defined(_MSC_VER)
+                unsigned long idx = 0;
+                _BitScanReverse64(&idx, f);
+                const int s = 63 - static_cast<int>(idx);
+#else
+                const int s = __builtin_clzll(f);
+#endif
+                return DiyFp(f << s, e - s);
+            }
+
+            // 求 v 与相邻可表示值的中点 m-、m+，两者指数对齐
+            void normalizedBoundaries(DiyFp& minus, DiyFp& plus) const {
+                DiyFp pl((f << 1) + 1, e - 1);
+                while (!(pl.f & (kHiddenBit << 1))) {
+                    pl.f <<= 1;
+                    --pl.e;
+                }
+                pl.f <<= 64 - 52 - 2;
+                pl.e -= 64 - 52 - 2;
+                DiyFp mi = (f == kHiddenBit) ? DiyFp((f << 2) - 1, e - 2) : DiyFp((f << 1) - 1, e - 1);
+                mi.f <<= mi.e - pl.e;
+                mi.e = pl.e;
+                plus = pl;
+                minus = mi;
+            }
+
+            enum { kExponentBias = 0x3FF + 52 };
+        };
+
+        // 10^K 的缓存近似值，使乘积的指数落在 [-60, -32]
+        static DiyFp cachedPower(int e, int& K) {
+            const double dk = (-61 - e) * 0.30102999566398114 + 347;
+            int k = static_cast<int>(dk);
+            if (dk - k > 0.0) ++k;
+            const unsigned index = static_cast<unsigned>((k >> 3) + 1);
+            K = -(-348 + static_cast<int>(index << 3));
+            return DiyFp(cachedPowersF()[index], cachedPowersE()[index]);
+        }
+
+        static void grisuRound(char* buffer, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+            while (rest < wp_w && delta - rest >= ten_kappa &&
+                   (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+                buffer[len - 1]--;
+                rest += ten_kappa;
+            }
+        }
+
+        static int countDecimalDigit32(uint32_t n) {
+            if (n < 10) return 1;
+            if (n < 100) return 2;
+            if (n < 1000) return 3;
+            if (n < 10000) return 4;
+            if (n < 100000) return 5;
+            if (n < 1000000) return 6;
+            if (n < 10000000) return 7;
+            if (n < 100000000) return 8;
+            return 9;
+        }
+
+        static void digitGen(const DiyFp& W, const DiyFp& Mp, uint64_t delta, char* buffer, int& len, int& K) {
+            static const uint64_t kPow10[] = {
+                1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+                1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+                100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+                1000000000000000000ULL, 10000000000000000000ULL
+            };
+            const DiyFp one(uint64_t(1) << -Mp.e, Mp.e);
+            const DiyFp wp_w = Mp - W;
+            uint32_t p1 = static_cast<uint32_t>(Mp.f >> -one.e);
+            uint64_t p2 = Mp.f & (one.f - 1);
+            int kappa = countDecimalDigit32(p1);
+            len = 0;
+
+            while (kappa > 0) {
+                const uint32_t div = static_cast<uint32_t>(kPow10[kappa - 1]);
+                const uint32_t d = p1 / div;
+                p1 %= div;
+                if (d || len) buffer[len++] = static_cast<char>('0' + d);
+                --kappa;
+                const uint64_t tmp = (static_cast<uint64_t>(p1) << -one.e) + p2;
+                if (tmp <= delta) {
+                    K += kappa;
+                    grisuRound(buffer, len, delta, tmp, kPow10[kappa] << -one.e, wp_w.f);
+                    return;
+                }
+            }
+
+            while (true) {
+                p2 *= 10;
+                delta *= 10;
+                const char d = static_cast<char>(p2 >> -one.e);
+                if (d || len) buffer[len++] = static_cast<char>('0' + d);
+                p2 &= one.f - 1;
+                --kappa;
+                if (p2 < delta) {
+                    K += kappa;
+                    const int index = -kappa;
+                    grisuRound(buffer, len, delta, p2, one.f, wp_w.f * (index < 20 ? kPow10[index] : 0));
+                    return;
+                }
+            }
+        }
+
+        // 生成十进制数字串 buffer[0, length)，值为 buffer * 10^K
+        static void grisu2(double value, char* buffer, int& length, int& K) {
+            const DiyFp v(value);
+            DiyFp w_m, w_p;
+            v.normalizedBoundaries(w_m, w_p);
+            const DiyFp c_mk = cachedPower(w_p.e, K);
+            const DiyFp W = v.normalize() * c_mk;
+            DiyFp Wp = w_p * c_mk;
+            DiyFp Wm = w_m * c_mk;
+            ++Wm.f;
+            --Wp.f;
+            digitGen(W, Wp, Wp.f - Wm.f, buffer, length, K);
+        }
+
+        static char* writeExponent(int K, char* buffer) {
+            if (K < 0) {
+                *buffer++ = '-';
+                K = -K;
+            }
+            if (K >= 100) {
+                *buffer++ = static_cast<char>('0' + K / 100);
+                K %= 100;
+                *buffer++ = digitPairs()[K * 2];
+                *buffer++ = digitPairs()[K * 2 + 1];
+            } else if (K >= 10) {
+                *buffer++ = digitPairs()[K * 2];
+                *buffer++ = digitPairs()[K * 2 + 1];
+            } else {
+                *buffer++ = static_cast<char>('0' + K);
+            }
+            return buffer;
+        }
+
+        // 把数字串排版为十进制或指数形式
+        static char* prettify(char* buffer, int length, int k) {
+            const int kk = length + k;   // 10^(kk-1) <= v < 10^kk
+            if (k >= 0 && kk <= 21) {
+                // 1234e7 -> 12340000000.0
+                for (int i = length; i < kk; ++i) buffer[i] = '0';
+                buffer[kk] = '.';
+                buffer[kk + 1] = '0';
+                return &buffer[kk + 2];
+            }
+            if (kk > 0 && kk <= 21) {
+                // 1234e-2 -> 12.34
+                std::memmove(&buffer[kk + 1], &buffer[kk], static_cast<size_t>(length - kk));
+                buffer[kk] = '.';
+                return &buffer[length + 1];
+            }
+            if (kk > -6 && kk <= 0) {
+                // 1234e-6 -> 0.001234
+                const int offset = 2 - kk;
+                std::memmove(&buffer[offset], &buffer[0], static_cast<size_t>(length));
+                buffer[0] = '0';
+                buffer[1] = '.';
+                for (int i = 2; i < offset; ++i) buffer[i] = '0';
+                return &buffer[length + offset];
+            }
+            if (length == 1) {
+                // 1e30
+                buffer[1] = 'e';
+                return writeExponent(kk - 1, &buffer[2]);
+            }
+            // 1234e30 -> 1.234e33
+            std::memmove(&buffer[2], &buffer[1], static_cast<size_t>(length - 1));
+            buffer[1] = '.';
+            buffer[length + 1] = 'e';
+            return writeExponent(kk - 1, &buffer[length + 2]);
+        }
+
+        static const uint64_t* cachedPowersF() {
+            static const uint64_t table[] = {
+                0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+                0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+                0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+                0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+                0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+                0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+                0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+                0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+                0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+                0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+                0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+                0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+                0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+                0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+                0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+                0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+                0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+                0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+                0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+                0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+                0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+                0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+                0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+                0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+                0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+                0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+                0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+                0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+                0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL,
+            };
+            return table;
+        }
+
+        static const int16_t* cachedPowersE() {
+            static const int16_t table[] = {
+                -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+                -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+                -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+                -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+                -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+                109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+                375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+                641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+                907, 933, 960, 986, 1013, 1039, 1066,
+            };
+            return table;
+        }
+};
+
+/**
+ * @brief 流式 JSON 写入器
+ *
+ * 按 SAX 事件的顺序调用 startObject/key/string/.../endObject，逗号、冒号和缩进由写入器补全。
+ * 输出写入内部可增长缓冲区（clear() 后容量保留复用），或调用方提供的定长缓冲区：
+ * 定长缓冲区写满时 overflow() 为真，之后的输出全部丢弃。
+ * 字符串转义用 SSE2 每次检查16字节，只对需要转义的字符逐个处理；
+ * 写入器不检查调用顺序是否构成合法 JSON，由调用方保证。
+ *
+ * 用法：
+ *   JsonWriter writer;
+ *   writer.startObject();
+ *   writer.key("id");
+ *   writer.int64Value(42);
+ *   writer.endObject();
+ *   send(writer.data(), writer.size());
+ */
+class JsonWriter {
+    public:
+        // 使用内部缓冲区；indent > 0 时输出带换行和缩进的格式
+        explicit JsonWriter(int indent = 0, size_t initial_capacity = 256)
+            : _owned(new char[initial_capacity ? initial_capacity : 1]),
+              _buf(_owned.get()), _cap(initial_capacity ? initial_capacity : 1), _indent(indent) {
+            _levels.reserve(32);
+        }
+
+        // 写入调用方提供的定长缓冲区，缓冲区须在写入器使用期间有效
+        JsonWriter(char* buffer, size_t capacity, int indent = 0)
+            : _buf(buffer), _cap(capacity), _indent(indent) {
+            _levels.reserve(32);
+        }
+
+        // 禁止拷贝
+        JsonWriter(const JsonWriter&) = delete;
+        JsonWriter& operator=(const JsonWriter&) = delete;
+
+        void startObject() {
+            beforeValue();
+            put('{');
+            _levels.push_back(kObject);
+        }
+
+        void endObject() {
+            endContainer('}');
+        }
+
+        void startArray() {
+            beforeValue();
+            put('[');
+            _levels.push_back(0);
+        }
+
+        void endArray() {
+            endContainer(']');
+        }
+
+        void key(const char* name, size_t len) {
+            beforeValue();
+            writeString(name, len);
+            if (_indent > 0) {
+                append(": ", 2);
+            } else {
+                put(':');
+            }
+            _after_key = true;
+        }
+
+        void key(const char* name) { key(name, std::strlen(name)); }
+        void key(const std::string& name) { key(name.data(), name.size()); }
+
+        void string(const char* value, size_t len) {
+            beforeValue();
+            writeString(value, len);
+        }
+
+        void string(const char* value) { string(value, std::strlen(value)); }
+        void string(const std::string& value) { string(value.data(), value.size()); }
+        void string(const JsonView& value) { string(value.data, value.size); }
+
+        void int64Value(int64_t value) {
+            beforeValue();
+            // 先格式化到栈上，定长缓冲区只按实际长度判断是否写得下
+            char tmp[32];
+            append(tmp, JsonNumberFormatter::formatInt64(value, tmp));
+        }
+
+        void uint64Value(uint64_t value) {
+            beforeValue();
+            char tmp[32];
+            append(tmp, JsonNumberFormatter::formatUInt64(value, tmp));
+        }
+
+        void doubleValue(double value) {
+            beforeValue();
+            char tmp[32];
+            append(tmp, JsonNumberFormatter::formatDouble(value, tmp));
+        }
+
+        void boolean(bool value) {
+            beforeValue();
+            if (value) {
+                append("true", 4);
+            } else {
+                append("false", 5);
+            }
+        }
+
+        void nullValue() {
+            beforeValue();
+            append("null", 4);
+        }
+
+        // 写入一段已序列化好的 JSON 值，原样输出
+        void rawValue(const char* json, size_t len) {
+            beforeValue();
+            append(json, len);
+        }
+
+        void rawValue(const JsonView& json) { rawValue(json.data, json.size); }
+
+        const char* data() const { return _buf; }
+        size_t size() const { return _size; }
+        JsonView view() const { return JsonView(_buf, _size); }
+        std::string toString() const { return std::string(_buf, _size); }
+
+        // 定长缓冲区是否已写满（输出不完整）
+        bool overflow() const { return _overflow; }
+
+        // 当前嵌套深度，为 0 且 size() > 0 时表示一个完整的值已写完
+        size_t depth() const { return _levels.size(); }
+
+        // 清空输出以便写下一条消息，缓冲区容量保留
+        void clear() {
+            _size = 0;
+            _levels.clear();
+            _after_key = false;
+            _overflow = false;
+        }
+
+        size_t capacity() const { return _cap; }
+
+    private:
+        enum {
+            kObject = 1,       // 当前层是对象
+            kHasItems = 2      // 当前层已有元素，下一个元素前需要逗号
+        };
+
+        // 保证还能写 n 字节，返回写入位置；定长缓冲区放不下时返回 nullptr
+        char* reserve(size_t n) {
+            if (_overflow) return nullptr;
+            if (_size + n <= _cap) return _buf + _size;
+            if (!_owned) {
+                _overflow = true;
+                return nullptr;
+            }
+            size_t new_cap = _cap * 2;
+            if (new_cap < _size + n) new_cap = _size + n;
+            std::unique_ptr<char[]> grown(new char[new_cap]);
+            std::memcpy(grown.get(), _buf, _size);
+            _owned = std::move(grown);
+            _buf = _owned.get();
+            _cap = new_cap;
+            return _buf + _size;
+        }
+
+        void put(char c) {
+            char* p = reserve(1);
+            if (p) {
+                *p = c;
+                ++_size;
+            }
+        }
+
+        void append(const char* s, size_t n) {
+            char* p = reserve(n);
+            if (p) {
+                std::memcpy(p, s, n);
+                _size += n;
+            }
+        }
+
+        void newline(size_t depth) {
+            const size_t n = 1 + depth * static_cast<size_t>(_indent);
+            char* p = reserve(n);
+            if (p) {
+                p[0] = '\n';
+                std::memset(p + 1, ' ', n - 1);
+                _size += n;
+            }
+        }
+
+        // 值或键之前：补逗号和缩进
+        void beforeValue() {
+            if (_after_key) {
+                _after_key = false;
+                return;
+            }
+            if (_levels.empty()) return;
+            uint8_t& level = _levels.back();
+            if (level & kHasItems) put(',');
+            level |= kHasItems;
+            if (_indent > 0) newline(_levels.size());
+        }
+
+        void endContainer(char close) {
+            if (_levels.empty()) return;
+            const bool has_items = (_levels.back() & kHasItems) != 0;
+            _levels.pop_back();
+            if (has_items && _indent > 0) newline(_levels.size());
+            put(close);
+        }
+
+        // 不需要转义的前缀长度
+        static size_t safePrefix(const char* s, size_t n) {
+            size_t i = 0;
+#if defined(JSON_SCANNER_AVX2) || defined(JSON_SCANNER_SSE2)
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control = _mm_set1_epi8(0x1F);
+            for (; i + 16 <= n; i += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+                // max(v, 0x1F) == 0x1F 即 v <= 0x1F（无符号比较）
+                const __m128i hit = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                    _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+                const int mask = _mm_movemask_epi8(hit);
+                if (mask) {
+                    return i + static_cast<size_t>(JsonStructuralScanner::trailingZeros(static_cast<uint64_t>(mask)));
+                }
+            }
+#endif
+            for (; i < n; ++i) {
+                const unsigned char c = static_cast<unsigned char>(s[i]);
+                if (c < 0x20 || c == '"' || c == '\\') break;
+            }
+            return i;
+        }
+
+        void writeString(const char* s, size_t n) {
+            put('"');
+            while (n > 0) {
+                const size_t run = safePrefix(s, n);
+                append(s, run);
+                s += run;
+                n -= run;
+                if (n == 0) break;
+                writeEscape(static_cast<unsigned char>(*s));
+                ++s;
+                --n;
+            }
+            put('"');
+        }
+
+        void writeEscape(unsigned char c) {
+            char esc[6] = {'\\', 0, 0, 0, 0, 0};
+            switch (c) {
+                case '"': esc[1] = '"'; break;
+                case '\\': esc[1] = '\\'; break;
+                case '\b': esc[1] = 'b'; break;
+                case '\f': esc[1] = 'f'; break;
+                case '\n': esc[1] = 'n'; break;
+                case '\r': esc[1] = 'r'; break;
+                case '\t': esc[1] = 't'; break;
+                default: {
+                    static const char hex[] = "0123456789abcdef";
+                    esc[1] = 'u';
+                    esc[2] = '0';
+                    esc[3] = '0';
+                    esc[4] = hex[c >> 4];
+                    esc[5] = hex[c & 0xF];
+                    append(esc, 6);
+                    return;
+                }
+            }
+            append(esc, 2);
+        }
+
+        std::unique_ptr<char[]> _owned;     // 内部缓冲区，定长模式下为空
+        char* _buf;
+        size_t _cap;
+        size_t _size = 0;
+        int _indent;
+        bool _after_key = false;            // 刚写完键，下一个值前不加逗号
+        bool _overflow = false;
+        std::vector<uint8_t> _levels;       // 每层容器的 kObject/kHasItems 标志
+};
+
+#endif // __JSON_WRITER_H__